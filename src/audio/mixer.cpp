@@ -436,6 +436,10 @@ void Channel::SetGroup(int group)
 Mixer::Mixer()
 {
 	effectbuffer = 0;
+	convertbuffer = 0;
+	convertbuffersize = 0;
+	commandhead = 0;
+	commandtail = 0;
 	volume = 1;
 	for (size_t i = 0; i < Util::CountOf(css1sources); i++) {
 		css1sources[i] = 0;
@@ -484,6 +488,8 @@ void Mixer::Close()
 	}
 	Unlock();
 	SDL_CloseAudioDevice(deviceid);
+	commandhead = 0;
+	commandtail = 0;
 	for (size_t i = 0; i < Util::CountOf(css1sources); i++) {
 		if (css1sources[i] && css1sources[i] != &source_null) {
 			delete css1sources[i];
@@ -500,6 +506,11 @@ void Mixer::Close()
 		delete[] effectbuffer;
 		effectbuffer = 0;
 	}
+	if (convertbuffer) {
+		delete[] convertbuffer;
+		convertbuffer = 0;
+		convertbuffersize = 0;
+	}
 }
 
 void Mixer::Lock()
@@ -528,9 +539,92 @@ Channel* Mixer::Play(Source& source, int loop, bool deleteondone, bool deletesou
 
 void Mixer::Stop(Channel& channel)
 {
-	Lock();
-	channel.stopping = true;
-	Unlock();
+	if (!PushCommand(channel, MIXER_COMMAND_STOP, 0)) {
+		Lock();
+		ProcessCommands();
+		channel.stopping = true;
+		Unlock();
+	}
+}
+
+void Mixer::SetChannelVolume(Channel& channel, int volume)
+{
+	if (!PushCommand(channel, MIXER_COMMAND_VOLUME, volume)) {
+		Lock();
+		ProcessCommands();
+		channel.SetVolume(volume);
+		Unlock();
+	}
+}
+
+void Mixer::SetChannelPan(Channel& channel, float pan)
+{
+	if (!PushCommand(channel, MIXER_COMMAND_PAN, pan)) {
+		Lock();
+		ProcessCommands();
+		channel.SetPan(pan);
+		Unlock();
+	}
+}
+
+void Mixer::SetChannelRate(Channel& channel, double rate)
+{
+	if (!PushCommand(channel, MIXER_COMMAND_RATE, rate)) {
+		Lock();
+		ProcessCommands();
+		channel.SetRate(rate);
+		Unlock();
+	}
+}
+
+/**
+ * Queues a channel parameter change for the audio callback without taking the audio device lock.
+ * Single producer (game thread), single consumer (audio callback). Returns false if the queue is
+ * full, in which case the caller drains the queue and applies the change under the lock instead,
+ * so that older queued commands can not overwrite the newer value.
+ */
+bool Mixer::PushCommand(Channel& channel, int type, double value)
+{
+	size_t tail = commandtail.load(std::memory_order_relaxed);
+	size_t next = (tail + 1) % MIXER_COMMAND_QUEUE_SIZE;
+	if (next == commandhead.load(std::memory_order_acquire)) {
+		return false;
+	}
+	commands[tail].channel = &channel;
+	commands[tail].type = type;
+	commands[tail].value = value;
+	commandtail.store(next, std::memory_order_release);
+	return true;
+}
+
+void Mixer::ProcessCommands()
+{
+	size_t head = commandhead.load(std::memory_order_relaxed);
+	size_t tail = commandtail.load(std::memory_order_acquire);
+	while (head != tail) {
+		ApplyCommand(commands[head]);
+		head = (head + 1) % MIXER_COMMAND_QUEUE_SIZE;
+	}
+	commandhead.store(head, std::memory_order_release);
+}
+
+void Mixer::ApplyCommand(const MixerCommand& command)
+{
+	Channel* channel = command.channel;
+	switch (command.type) {
+	case MIXER_COMMAND_VOLUME:
+		channel->SetVolume((int)command.value);
+		break;
+	case MIXER_COMMAND_PAN:
+		channel->SetPan((float)command.value);
+		break;
+	case MIXER_COMMAND_RATE:
+		channel->SetRate(command.value);
+		break;
+	case MIXER_COMMAND_STOP:
+		channel->stopping = true;
+		break;
+	}
 }
 
 bool Mixer::LoadMusic(size_t pathId)
@@ -542,6 +636,7 @@ bool Mixer::LoadMusic(size_t pathId)
 		const char* filename = get_file_path(pathId);
 		Source_Sample* source_sample = new Source_Sample;
 		if (source_sample->LoadWAV(filename)) {
+			source_sample->Convert(format); // convert to audio output format so the callback can mix it directly
 			musicsources[pathId] = source_sample;
 			return true;
 		} else {
@@ -563,6 +658,7 @@ void SDLCALL Mixer::Callback(void* arg, uint8* stream, int length)
 {
 	Mixer* mixer = (Mixer*)arg;
 	memset(stream, 0, length);
+	mixer->ProcessCommands();
 	std::list<Channel*>::iterator i = mixer->channels.begin();
 	while (i != mixer->channels.end()) {
 		mixer->MixChannel(*(*i), stream, length);
@@ -712,10 +808,6 @@ void Mixer::MixChannel(Channel& channel, uint8* data, int length)
 
 				SDL_MixAudioFormat(&data[loaded], tomix, format.format, mixlength, mixvolume);
 
-				if (dataconverted) {
-					delete[] dataconverted;
-				}
-
 				channel.offset += readfromstream;
 			}
 
@@ -738,48 +830,52 @@ void Mixer::MixChannel(Channel& channel, uint8* data, int length)
 	}
 }
 
+// The effect kernels derive each sample's gain from its index rather than accumulating it across
+// iterations, so there is no loop-carried dependency and the compiler can vectorise them.
+
 void Mixer::EffectPanS16(Channel& channel, sint16* data, int length)
 {
 	const float dt = 1.0f / (length * 2);
-	float left_volume = channel.oldvolume_l;
-	float right_volume = channel.oldvolume_r;
+	const float left_volume = channel.oldvolume_l;
+	const float right_volume = channel.oldvolume_r;
 	const float d_left = dt * (channel.volume_l - channel.oldvolume_l);
 	const float d_right = dt * (channel.volume_r - channel.oldvolume_r);
 
-	for (int i = 0; i < length * 2; i += 2) {
-		data[i] = (sint16)(data[i] * left_volume);
-		data[i + 1] = (sint16)(data[i + 1] * right_volume);
-		left_volume += d_left;
-		right_volume += d_right;
+	for (int i = 0; i < length; i++) {
+		data[i * 2] = (sint16)(data[i * 2] * (left_volume + i * d_left));
+		data[i * 2 + 1] = (sint16)(data[i * 2 + 1] * (right_volume + i * d_right));
 	}
 }
 
 void Mixer::EffectPanU8(Channel& channel, uint8* data, int length)
 {
-	for (int i = 0; i < length * 2; i += 2) {
-		float t = (float)i / (length * 2);
-		data[i] = (uint8)(data[i] * ((1.0 - t) * channel.oldvolume_l + t * channel.volume_l));
-		data[i + 1] = (uint8)(data[i + 1] * ((1.0 - t) * channel.oldvolume_r + t * channel.volume_r));
+	const float dt = 1.0f / length;
+	const float left_volume = channel.oldvolume_l;
+	const float right_volume = channel.oldvolume_r;
+	const float d_left = dt * (channel.volume_l - channel.oldvolume_l);
+	const float d_right = dt * (channel.volume_r - channel.oldvolume_r);
+
+	for (int i = 0; i < length; i++) {
+		data[i * 2] = (uint8)(data[i * 2] * (left_volume + i * d_left));
+		data[i * 2 + 1] = (uint8)(data[i * 2 + 1] * (right_volume + i * d_right));
 	}
 }
 
 void Mixer::EffectFadeS16(sint16* data, int length, int startvolume, int endvolume)
 {
-	float startvolume_f = (float)startvolume / SDL_MIX_MAXVOLUME;
-	float endvolume_f = (float)endvolume / SDL_MIX_MAXVOLUME;
+	const float startvolume_f = (float)startvolume / SDL_MIX_MAXVOLUME;
+	const float d_volume = ((float)(endvolume - startvolume) / SDL_MIX_MAXVOLUME) / length;
 	for (int i = 0; i < length; i++) {
-		float t = (float)i / length;
-		data[i] = (sint16)(data[i] * ((1 - t) * startvolume_f + t * endvolume_f));
+		data[i] = (sint16)(data[i] * (startvolume_f + i * d_volume));
 	}
 }
 
 void Mixer::EffectFadeU8(uint8* data, int length, int startvolume, int endvolume)
 {
-	float startvolume_f = (float)startvolume / SDL_MIX_MAXVOLUME;
-	float endvolume_f = (float)endvolume / SDL_MIX_MAXVOLUME;
+	const float startvolume_f = (float)startvolume / SDL_MIX_MAXVOLUME;
+	const float d_volume = ((float)(endvolume - startvolume) / SDL_MIX_MAXVOLUME) / length;
 	for (int i = 0; i < length; i++) {
-		float t = (float)i / length;
-		data[i] = (uint8)(data[i] * ((1 - t) * startvolume_f + t * endvolume_f));
+		data[i] = (uint8)(data[i] * (startvolume_f + i * d_volume));
 	}
 }
 
@@ -797,11 +893,19 @@ bool Mixer::Convert(SDL_AudioCVT& cvt, const uint8* data, unsigned long length,
 	if (length == 0 || cvt.len_mult == 0) {
 		return false;
 	}
+	// Reuse one conversion buffer across callbacks rather than allocating on the audio thread every time
+	unsigned long size = length * cvt.len_mult;
+	if (size > convertbuffersize) {
+		if (convertbuffer) {
+			delete[] convertbuffer;
+		}
+		convertbuffer = new uint8[size];
+		convertbuffersize = size;
+	}
 	cvt.len = length;
-	cvt.buf = (Uint8*)new uint8[cvt.len * cvt.len_mult];
+	cvt.buf = (Uint8*)convertbuffer;
 	memcpy(cvt.buf, data, length);
 	if (SDL_ConvertAudio(&cvt) < 0) {
-		delete[] cvt.buf;
 		return false;
 	}
 	*dataout = cvt.buf;
@@ -848,27 +952,21 @@ void Mixer_Channel_Volume(void* channel, int volume)
 {
 	if (gOpenRCT2Headless) return;
 
-	gMixer.Lock();
-	((Channel*)channel)->SetVolume(volume);
-	gMixer.Unlock();
+	gMixer.SetChannelVolume(*(Channel*)channel, volume);
 }
 
 void Mixer_Channel_Pan(void* channel, float pan)
 {
 	if (gOpenRCT2Headless) return;
 
-	gMixer.Lock();
-	((Channel*)channel)->SetPan(pan);
-	gMixer.Unlock();
+	gMixer.SetChannelPan(*(Channel*)channel, pan);
 }
 
 void Mixer_Channel_Rate(void* channel, double rate)
 {
 	if (gOpenRCT2Headless) return;
 
-	gMixer.Lock();
-	((Channel*)channel)->SetRate(rate);
-	gMixer.Unlock();
+	gMixer.SetChannelRate(*(Channel*)channel, rate);
 }
 
 int Mixer_Channel_IsPlaying(void* channel)
@@ -42,6 +42,7 @@ enum {
 
 #ifdef __cplusplus
 
+#include <atomic>
 #include <list>
 extern "C" {
 #include <speex/speex_resampler.h>
@@ -157,6 +158,22 @@ private:
 	Source* source = nullptr;
 };
 
+enum {
+	MIXER_COMMAND_VOLUME,
+	MIXER_COMMAND_PAN,
+	MIXER_COMMAND_RATE,
+	MIXER_COMMAND_STOP,
+};
+
+#define MIXER_COMMAND_QUEUE_SIZE 256
+
+// Channel parameter change queued by the game thread and applied at the start of the next audio callback
+struct MixerCommand {
+	Channel* channel;
+	int type;
+	double value;
+};
+
 class Mixer
 {
 public:
@@ -167,6 +184,9 @@ public:
 	void Unlock();
 	Channel* Play(Source& source, int loop, bool deleteondone, bool deletesourceondone);
 	void Stop(Channel& channel);
+	void SetChannelVolume(Channel& channel, int volume);
+	void SetChannelPan(Channel& channel, float pan);
+	void SetChannelRate(Channel& channel, double rate);
 	bool LoadMusic(size_t pathid);
 	void SetVolume(float volume);
 
@@ -175,6 +195,9 @@ public:
 
 private:
 	static void SDLCALL Callback(void* arg, uint8* data, int length);
+	bool PushCommand(Channel& channel, int type, double value);
+	void ProcessCommands();
+	void ApplyCommand(const MixerCommand& command);
 	void MixChannel(Channel& channel, uint8* buffer, int length);
 	void EffectPanS16(Channel& channel, sint16* data, int length);
 	void EffectPanU8(Channel& channel, uint8* data, int length);
@@ -185,6 +208,11 @@ private:
 	SDL_AudioDeviceID deviceid;
 	AudioFormat format;
 	uint8* effectbuffer;
+	uint8* convertbuffer;
+	unsigned long convertbuffersize;
+	MixerCommand commands[MIXER_COMMAND_QUEUE_SIZE];
+	std::atomic<size_t> commandhead;
+	std::atomic<size_t> commandtail;
 	std::list<Channel*> channels;
 	Source_Null source_null;
 	float volume;
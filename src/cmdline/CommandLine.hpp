@@ -93,4 +93,5 @@ namespace CommandLine
     exitcode_t HandleCommandDefault();
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator * enumerator);
+    exitcode_t HandleCommandMapGen(CommandLineArgEnumerator * enumerator);
 }
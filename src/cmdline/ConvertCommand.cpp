@@ -2,6 +2,7 @@
 #include "../core/Console.hpp"
 #include "../core/Exception.hpp"
 #include "../core/Path.hpp"
+#include "../core/String.hpp"
 #include "../rct1/S4Importer.h"
 #include "CommandLine.hpp"
 
@@ -10,9 +11,13 @@ extern "C"
     #include "../game.h"
     #include "../scenario.h"
     #include "../openrct2.h"
+    #include "../rct2.h"
     #include "../interface/window.h"
+    #include "../platform/platform.h"
 }
 
+static exitcode_t HandleBatchConvert(const utf8 * sourceDirectory, const utf8 * destinationDirectory);
+static bool ConvertFile(const utf8 * sourcePath, uint32 sourceFileType, const utf8 * destinationPath, uint32 destinationFileType);
 static void WriteConvertFromAndToMessage(uint32 sourceFileType, uint32 destinationFileType);
 static const utf8 * GetFileTypeFriendlyName(uint32 fileType);
 
@@ -46,6 +51,13 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator * enumerat
 
     utf8 destinationPath[MAX_PATH];
     Path::GetAbsolute(destinationPath, sizeof(sourcePath), rawDestinationPath);
+
+    // A directory of RCT1 files is converted in one go, sharing a single initialisation
+    if (platform_directory_exists(sourcePath))
+    {
+        return HandleBatchConvert(sourcePath, destinationPath);
+    }
+
     uint32 destinationFileType = get_file_extension_type(destinationPath);
 
     // Validate target type
@@ -89,6 +101,98 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator * enumerat
         return EXITCODE_FAIL;
     }
 
+    if (!ConvertFile(sourcePath, sourceFileType, destinationPath, destinationFileType))
+    {
+        return EXITCODE_FAIL;
+    }
+    Console::WriteLine("Conversion successful!");
+    return EXITCODE_OK;
+}
+
+/**
+ * Converts every .SC4 and .SV4 file in a directory to a .SC6 or .SV6 in the destination directory.
+ * OpenRCT2 and the object repository are only initialised once for all of the files. Each file is
+ * reported on its own line as tab separated status, time in milliseconds, source and destination.
+ */
+static exitcode_t HandleBatchConvert(const utf8 * sourceDirectory, const utf8 * destinationDirectory)
+{
+    if (!platform_ensure_directory_exists(destinationDirectory))
+    {
+        Console::Error::WriteLine("Unable to create destination directory.");
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    if (!openrct2_initialise()) {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        return EXITCODE_FAIL;
+    }
+
+    utf8 pattern[MAX_PATH];
+    String::Set(pattern, sizeof(pattern), sourceDirectory);
+    Path::Append(pattern, sizeof(pattern), "*");
+
+    int numConverted = 0;
+    int numFailed = 0;
+    int handle = platform_enumerate_files_begin(pattern);
+    if (handle != INVALID_HANDLE)
+    {
+        file_info fileInfo;
+        while (platform_enumerate_files_next(handle, &fileInfo))
+        {
+            uint32 sourceFileType = get_file_extension_type(fileInfo.path);
+            uint32 destinationFileType;
+            const utf8 * destinationExtension;
+            switch (sourceFileType) {
+            case FILE_EXTENSION_SC4:
+                destinationFileType = FILE_EXTENSION_SC6;
+                destinationExtension = ".sc6";
+                break;
+            case FILE_EXTENSION_SV4:
+                destinationFileType = FILE_EXTENSION_SV6;
+                destinationExtension = ".sv6";
+                break;
+            default:
+                continue;
+            }
+
+            utf8 sourcePath[MAX_PATH];
+            String::Set(sourcePath, sizeof(sourcePath), sourceDirectory);
+            Path::Append(sourcePath, sizeof(sourcePath), fileInfo.path);
+
+            utf8 destinationName[MAX_PATH];
+            Path::GetFileNameWithoutExtension(destinationName, sizeof(destinationName), fileInfo.path);
+            String::Append(destinationName, sizeof(destinationName), destinationExtension);
+
+            utf8 destinationPath[MAX_PATH];
+            String::Set(destinationPath, sizeof(destinationPath), destinationDirectory);
+            Path::Append(destinationPath, sizeof(destinationPath), destinationName);
+
+            uint32 startTicks = platform_get_ticks();
+            bool success = ConvertFile(sourcePath, sourceFileType, destinationPath, destinationFileType);
+            uint32 duration = platform_get_ticks() - startTicks;
+
+            Console::WriteFormat("%s\t%u\t%s\t%s", success ? "ok" : "failed", duration, sourcePath, destinationPath);
+            Console::WriteLine();
+            if (success)
+            {
+                numConverted++;
+            }
+            else
+            {
+                numFailed++;
+            }
+        }
+        platform_enumerate_files_end(handle);
+    }
+
+    Console::WriteFormat("Converted %d files, %d failed.", numConverted, numFailed);
+    Console::WriteLine();
+    return numFailed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+static bool ConvertFile(const utf8 * sourcePath, uint32 sourceFileType, const utf8 * destinationPath, uint32 destinationFileType)
+{
     if (sourceFileType == FILE_EXTENSION_SV4 ||
         sourceFileType == FILE_EXTENSION_SC4)
     {
@@ -115,8 +219,10 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator * enumerat
         catch (Exception ex)
         {
             Console::Error::WriteLine(ex.GetMsg());
-            return EXITCODE_FAIL;
+            delete s4Importer;
+            return false;
         }
+        delete s4Importer;
     }
     else
     {
@@ -131,28 +237,26 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator * enumerat
     }
 
     SDL_RWops* rw = SDL_RWFromFile(destinationPath, "wb+");
-    if (rw != NULL) {
-        // HACK remove the main window so it saves the park with the
-        //      correct initial view
-        window_close_by_class(WC_MAIN_WINDOW);
+    if (rw == NULL)
+    {
+        Console::Error::WriteLine("Unable to write destination file.");
+        return false;
+    }
 
-        if (destinationFileType == FILE_EXTENSION_SC6)
-        {
-            scenario_save(rw, 0x80000002);
-        }
-        else
-        {
-            scenario_save(rw, 0x80000001);
-        }
-        SDL_RWclose(rw);
-        Console::WriteLine("Conversion successful!");
+    // HACK remove the main window so it saves the park with the
+    //      correct initial view
+    window_close_by_class(WC_MAIN_WINDOW);
+
+    if (destinationFileType == FILE_EXTENSION_SC6)
+    {
+        scenario_save(rw, 0x80000002);
     }
     else
     {
-        Console::Error::WriteLine("Unable to write destination file.");
-        return EXITCODE_FAIL;
+        scenario_save(rw, 0x80000001);
     }
-    return EXITCODE_OK;
+    SDL_RWclose(rw);
+    return true;
 }
 
 static void WriteConvertFromAndToMessage(uint32 sourceFileType, uint32 destinationFileType)
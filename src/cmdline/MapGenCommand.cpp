@@ -0,0 +1,104 @@
+#include <time.h>
+
+#include "../common.h"
+#include "../core/Console.hpp"
+#include "../core/Path.hpp"
+#include "CommandLine.hpp"
+
+extern "C"
+{
+    #include "../editor.h"
+    #include "../openrct2.h"
+    #include "../rct2.h"
+    #include "../scenario.h"
+    #include "../interface/window.h"
+    #include "../util/util.h"
+    #include "../world/map.h"
+    #include "../world/mapgen.h"
+}
+
+#define MAPGEN_DEFAULT_MAP_SIZE 150
+
+exitcode_t CommandLine::HandleCommandMapGen(CommandLineArgEnumerator * enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
+    {
+        return result;
+    }
+
+    // Get the destination path
+    const utf8 * rawDestinationPath;
+    if (!enumerator->TryPopString(&rawDestinationPath))
+    {
+        Console::Error::WriteLine("Expected a destination path.");
+        return EXITCODE_FAIL;
+    }
+
+    utf8 destinationPath[MAX_PATH];
+    Path::GetAbsolute(destinationPath, sizeof(destinationPath), rawDestinationPath);
+    if (get_file_extension_type(destinationPath) != FILE_EXTENSION_SV6)
+    {
+        Console::Error::WriteLine("Only generating a .SV6 is supported.");
+        return EXITCODE_FAIL;
+    }
+
+    // Optional map size and seed
+    sint32 mapSize = MAPGEN_DEFAULT_MAP_SIZE;
+    sint32 seed = 0;
+    if (enumerator->TryPopInteger(&mapSize))
+    {
+        enumerator->TryPopInteger(&seed);
+    }
+    if (mapSize < MINIMUM_MAP_SIZE_TECHNICAL || mapSize > MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        Console::Error::WriteFormat("Map size must be between %d and %d.", MINIMUM_MAP_SIZE_TECHNICAL, MAXIMUM_MAP_SIZE_TECHNICAL);
+        Console::Error::WriteLine();
+        return EXITCODE_FAIL;
+    }
+
+    gOpenRCT2Headless = true;
+    if (!openrct2_initialise())
+    {
+        Console::Error::WriteLine("Error while initialising OpenRCT2.");
+        return EXITCODE_FAIL;
+    }
+
+    editor_load();
+
+    // Same settings as the random page of the map generator window, derived from the seed
+    mapgen_settings settings;
+    settings.mapSize = mapSize;
+    settings.height = 12 + 2;
+    settings.waterLevel = 16 + 2;
+    settings.floor = -1;
+    settings.wall = -1;
+    settings.trees = 1;
+    settings.seed = seed != 0 ? (unsigned int)seed : (unsigned int)time(NULL);
+
+    util_srand(settings.seed);
+    settings.simplex_low = util_rand() % 4;
+    settings.simplex_high = 12 + (util_rand() % (32 - 12));
+    settings.simplex_base_freq = 1.75f;
+    settings.simplex_octaves = 6;
+
+    mapgen_generate(&settings);
+
+    SDL_RWops * rw = SDL_RWFromFile(destinationPath, "wb+");
+    if (rw == NULL)
+    {
+        Console::Error::WriteLine("Unable to write destination file.");
+        return EXITCODE_FAIL;
+    }
+
+    // HACK remove the main window so it saves the park with the
+    //      correct initial view
+    window_close_by_class(WC_MAIN_WINDOW);
+
+    scenario_save(rw, 0x80000001);
+    SDL_RWclose(rw);
+
+    Console::WriteFormat("Generated a %dx%d map with seed %u.", mapSize, mapSize, settings.seed);
+    Console::WriteLine();
+    return EXITCODE_OK;
+}
@@ -40,6 +40,23 @@ typedef struct { uint8 b, g, r, a; } rct_sprite_file_palette_entry;
 rct_sprite_file_palette_entry spriteFilePalette[256];
 static rct_sprite_file_palette_entry _standardPalette[256];
 
+#define PALETTE_EXACT_TABLE_SIZE 512
+#define PALETTE_CLOSEST_CACHE_SIZE 8192
+#define PALETTE_COLOUR_EMPTY 0xFFFFFFFF
+
+typedef struct {
+	uint32 colour;
+	sint16 index;
+} palette_lookup_entry;
+
+// Lookups for the palette in spriteFilePalette, rebuilt whenever that palette changes
+static rct_sprite_file_palette_entry _lookupPalette[256];
+static bool _lookupPaletteValid = false;
+static uint8 _changablePaletteIndices[256];
+static int _numChangablePaletteIndices;
+static palette_lookup_entry _exactColourTable[PALETTE_EXACT_TABLE_SIZE];
+static palette_lookup_entry _closestColourCache[PALETTE_CLOSEST_CACHE_SIZE];
+
 rct_sprite_file_header spriteFileHeader;
 rct_g1_element *spriteFileEntries;
 uint8 *spriteFileData;
@@ -198,38 +215,104 @@ bool is_changable_pixel(int palette_index) {
 	return true;
 }
 
-int get_closest_palette_index(sint16 *colour){
+static uint32 palette_lookup_hash(uint32 colour)
+{
+	// Fibonacci hashing, the low bits of the product are poorly mixed so use the upper half
+	return (colour * 2654435761u) >> 16;
+}
+
+/**
+ * Packs a colour into 24 bits, or returns PALETTE_COLOUR_EMPTY if a component is outside 0-255
+ * which dithering can produce. Such colours never match a palette entry exactly.
+ */
+static uint32 palette_lookup_pack_colour(sint16 *colour)
+{
+	if ((uint16)colour[0] > 255 || (uint16)colour[1] > 255 || (uint16)colour[2] > 255)
+		return PALETTE_COLOUR_EMPTY;
+	return (colour[0] << 16) | (colour[1] << 8) | colour[2];
+}
+
+/**
+ * Builds the exact match table and list of changable indices for the current sprite file palette.
+ * Called once per import, only rebuilds if the palette has changed since the last import.
+ */
+static void palette_lookup_update()
+{
+	if (_lookupPaletteValid && memcmp(_lookupPalette, spriteFilePalette, sizeof(_lookupPalette)) == 0)
+		return;
+
+	memcpy(_lookupPalette, spriteFilePalette, sizeof(_lookupPalette));
+	memset(_exactColourTable, 0xFF, sizeof(_exactColourTable));
+	memset(_closestColourCache, 0xFF, sizeof(_closestColourCache));
+
+	_numChangablePaletteIndices = 0;
+	for (int i = 0; i < 256; i++) {
+		if (is_changable_pixel(i))
+			_changablePaletteIndices[_numChangablePaletteIndices++] = i;
+
+		// The first index with a colour wins, the same as a linear search
+		uint32 colour = (spriteFilePalette[i].r << 16) | (spriteFilePalette[i].g << 8) | spriteFilePalette[i].b;
+		uint32 slot = palette_lookup_hash(colour) % PALETTE_EXACT_TABLE_SIZE;
+		while (_exactColourTable[slot].colour != PALETTE_COLOUR_EMPTY && _exactColourTable[slot].colour != colour)
+			slot = (slot + 1) % PALETTE_EXACT_TABLE_SIZE;
+		if (_exactColourTable[slot].colour == PALETTE_COLOUR_EMPTY) {
+			_exactColourTable[slot].colour = colour;
+			_exactColourTable[slot].index = i;
+		}
+	}
+	_lookupPaletteValid = true;
+}
+
+static int get_closest_palette_index_uncached(sint16 *colour)
+{
 	uint32 smallest_error = -1;
 	int best_match = -1;
 
-	for (int x = 0; x < 256; x++){
-		if (is_changable_pixel(x)){
-			uint32 error =
-				((sint16)(spriteFilePalette[x].r) - colour[0]) * ((sint16)(spriteFilePalette[x].r) - colour[0]) +
-				((sint16)(spriteFilePalette[x].g) - colour[1]) * ((sint16)(spriteFilePalette[x].g) - colour[1]) +
-				((sint16)(spriteFilePalette[x].b) - colour[2]) * ((sint16)(spriteFilePalette[x].b) - colour[2]);
+	for (int i = 0; i < _numChangablePaletteIndices; i++){
+		int x = _changablePaletteIndices[i];
+		uint32 error =
+			((sint16)(spriteFilePalette[x].r) - colour[0]) * ((sint16)(spriteFilePalette[x].r) - colour[0]) +
+			((sint16)(spriteFilePalette[x].g) - colour[1]) * ((sint16)(spriteFilePalette[x].g) - colour[1]) +
+			((sint16)(spriteFilePalette[x].b) - colour[2]) * ((sint16)(spriteFilePalette[x].b) - colour[2]);
 
-			if (smallest_error == -1 || smallest_error > error){
-				best_match = x;
-				smallest_error = error;
-			}
+		if (smallest_error == -1 || smallest_error > error){
+			best_match = x;
+			smallest_error = error;
 		}
 	}
 	return best_match;
 }
 
+int get_closest_palette_index(sint16 *colour){
+	// Sprites reuse few colours so remember the result for each colour, dithered colours outside
+	// the 0-255 range are rare and always searched for
+	uint32 packedColour = palette_lookup_pack_colour(colour);
+	if (packedColour == PALETTE_COLOUR_EMPTY)
+		return get_closest_palette_index_uncached(colour);
+
+	palette_lookup_entry *entry = &_closestColourCache[palette_lookup_hash(packedColour) % PALETTE_CLOSEST_CACHE_SIZE];
+	if (entry->colour != packedColour) {
+		entry->colour = packedColour;
+		entry->index = get_closest_palette_index_uncached(colour);
+	}
+	return entry->index;
+}
+
 int get_palette_index(sint16 *colour)
 {
 	if (is_transparent_pixel(colour))
 		return -1;
 
-	for (int i = 0; i < 256; i++) {
-		if ((sint16)(spriteFilePalette[i].r) != colour[0]) continue;
-		if ((sint16)(spriteFilePalette[i].g) != colour[1]) continue;
-		if ((sint16)(spriteFilePalette[i].b) != colour[2]) continue;
-		return i;
-	}
+	uint32 packedColour = palette_lookup_pack_colour(colour);
+	if (packedColour == PALETTE_COLOUR_EMPTY)
+		return -1;
 
+	uint32 slot = palette_lookup_hash(packedColour) % PALETTE_EXACT_TABLE_SIZE;
+	while (_exactColourTable[slot].colour != PALETTE_COLOUR_EMPTY) {
+		if (_exactColourTable[slot].colour == packedColour)
+			return _exactColourTable[slot].index;
+		slot = (slot + 1) % PALETTE_EXACT_TABLE_SIZE;
+	}
 	return -1;
 }
 
@@ -254,6 +337,7 @@ bool sprite_file_import(const char *path, rct_g1_element *outElement, uint8 **ou
 	}
 
 	memcpy(spriteFilePalette, _standardPalette, 256 * 4);
+	palette_lookup_update();
 
 	uint8 *buffer = malloc((height * 2) + (width * height * 16));
 	memset(buffer, 0, (height * 2) + (width * height * 16));
@@ -592,12 +676,16 @@ int cmdline_for_sprite(const char **argv, int argc)
 		int resourceLength = strlen(resourcePath);
 
 		bool silent = (argc >= 4 && strcmp(argv[3], "silent") == 0);
-		bool fileExists = true;
 		SDL_RWops *file;
 
+		// Collect all the images in memory and only write the sprite file once at the end,
+		// entry offsets are kept relative to the start of the data until then
+		uint32 entriesCapacity = 0;
+		uint32 dataCapacity = 0;
 		spriteFileHeader.num_entries = 0;
 		spriteFileHeader.total_size = 0;
-		sprite_file_save(spriteFilePath);
+		spriteFileEntries = NULL;
+		spriteFileData = NULL;
 
 		fprintf(stdout, "Building: %s\n", spriteFilePath);
 		int i = 0;
@@ -616,38 +704,40 @@ int cmdline_for_sprite(const char **argv, int argc)
 				int bufferLength;
 				if (!sprite_file_import(imagePath, &spriteElement, &buffer, &bufferLength, gSpriteMode)) {
 					fprintf(stderr, "Could not import image file: %s\nCanceling\n", imagePath);
+					sprite_file_close();
 					return -1;
 				}
 
-				if (!sprite_file_open(spriteFilePath)) {
-					fprintf(stderr, "Unable to open sprite file: %s\nCanceling\n", spriteFilePath);
-					return -1;
+				if (spriteFileHeader.num_entries == entriesCapacity) {
+					entriesCapacity = max(256, entriesCapacity * 2);
+					spriteFileEntries = realloc(spriteFileEntries, entriesCapacity * sizeof(rct_g1_element));
+				}
+				if (spriteFileHeader.total_size + bufferLength > dataCapacity) {
+					dataCapacity = max(spriteFileHeader.total_size + bufferLength, dataCapacity * 2);
+					spriteFileData = realloc(spriteFileData, dataCapacity);
 				}
 
+				spriteElement.offset = (uint8*)spriteFileHeader.total_size;
+				spriteFileEntries[spriteFileHeader.num_entries] = spriteElement;
+				memcpy(spriteFileData + spriteFileHeader.total_size, buffer, bufferLength);
 				spriteFileHeader.num_entries++;
 				spriteFileHeader.total_size += bufferLength;
-				spriteFileEntries = realloc(spriteFileEntries, spriteFileHeader.num_entries * sizeof(rct_g1_element));
-
-				sprite_entries_make_relative();
-				spriteFileData = realloc(spriteFileData, spriteFileHeader.total_size);
-				sprite_entries_make_absolute();
-
-				spriteFileEntries[spriteFileHeader.num_entries - 1] = spriteElement;
-				memcpy(spriteFileData + (spriteFileHeader.total_size - bufferLength), buffer, bufferLength);
-				spriteFileEntries[spriteFileHeader.num_entries - 1].offset = spriteFileData + (spriteFileHeader.total_size - bufferLength);
 
 				free(buffer);
 
-				if (!sprite_file_save(spriteFilePath)) {
-					fprintf(stderr, "Could not save sprite file: %s\nCanceling\n", imagePath);
-					return -1;
-				}
 				if (!silent)
 					fprintf(stdout, "Added: %s\n", imagePath);
 			}
 			i++;
 		} while (file != NULL);
 
+		sprite_entries_make_absolute();
+		if (!sprite_file_save(spriteFilePath)) {
+			fprintf(stderr, "Could not save sprite file: %s\nCanceling\n", spriteFilePath);
+			sprite_file_close();
+			return -1;
+		}
+		sprite_file_close();
 
 		fprintf(stdout, "Finished\n");
 		return 1;
@@ -51,4 +51,14 @@
 #define FASTCALL
 #endif // PLATFORM_X86
 
+// Hint that the memory at x will be read soon, for walks the hardware prefetcher can't predict
+#if defined(__GNUC__)
+#define PREFETCH(x) __builtin_prefetch(x)
+#elif defined(_MSC_VER)
+#include <xmmintrin.h>
+#define PREFETCH(x) _mm_prefetch((const char*)(x), _MM_HINT_T0)
+#else
+#define PREFETCH(x)
+#endif
+
 #endif
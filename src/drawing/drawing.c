@@ -24,6 +24,7 @@
 #include "../interface/window.h"
 #include "../platform/platform.h"
 #include "../object.h"
+#include "../util/util.h"
 #include "../world/water.h"
 #include "drawing.h"
 
@@ -31,8 +32,10 @@
 int gLastDrawStringX;
 int gLastDrawStringY;
 
-uint8* _screenDirtyBlocks = NULL;
+// One bit per block, each row of the grid starts on a new word
+uint32* _screenDirtyBlocks = NULL;
 int _screenDirtyBlocksSize = 0;
+uint16 _screenDirtyBlockRowWords;
 uint16 _screenDirtyBlockWidth;
 uint16 _screenDirtyBlockHeight;
 uint16 _screenDirtyBlockColumns;
@@ -43,6 +46,8 @@ uint8 _screenDirtyBlockShiftY;
 rct_drawpixelinfo gScreenDPI;
 rct_drawpixelinfo gWindowDPI;
 
+uint32 gDirtyBlockRectsDrawn;
+
 #define MAX_RAIN_PIXELS 0xFFFE
 static uint32 _rainPixels[MAX_RAIN_PIXELS];
 static uint32 _numRainPixels;
@@ -208,20 +213,56 @@ void gfx_invalidate_screen()
 	gfx_set_dirty_blocks(0, 0, gScreenWidth, gScreenHeight);
 }
 
-uint8* gfx_get_dirty_blocks()
+uint32* gfx_get_dirty_blocks()
 {
-	int size = _screenDirtyBlockColumns * _screenDirtyBlockRows;
+	int size = _screenDirtyBlockRowWords * _screenDirtyBlockRows;
 	if (_screenDirtyBlocksSize != size) {
 		if (_screenDirtyBlocks) {
-			_screenDirtyBlocks = realloc(_screenDirtyBlocks, size);
+			_screenDirtyBlocks = realloc(_screenDirtyBlocks, size * sizeof(uint32));
 		} else {
-			_screenDirtyBlocks = malloc(size);
+			_screenDirtyBlocks = malloc(size * sizeof(uint32));
 		}
+		memset(_screenDirtyBlocks, 0, size * sizeof(uint32));
 		_screenDirtyBlocksSize = size;
 	}
 	return _screenDirtyBlocks;
 }
 
+/**
+ * Returns the mask of the bits from..to (inclusive) that fall in the word starting at block wordStart.
+ */
+static uint32 dirty_block_word_mask(int wordStart, int from, int to)
+{
+	int lo = max(from - wordStart, 0);
+	int hi = min(to - wordStart, 31);
+	uint32 mask = 0xFFFFFFFF << lo;
+	if (hi < 31)
+		mask &= (2u << hi) - 1;
+	return mask;
+}
+
+static void dirty_block_row_set(uint32 *row, int from, int to)
+{
+	for (int word = from >> 5; word <= to >> 5; word++)
+		row[word] |= dirty_block_word_mask(word << 5, from, to);
+}
+
+static void dirty_block_row_clear(uint32 *row, int from, int to)
+{
+	for (int word = from >> 5; word <= to >> 5; word++)
+		row[word] &= ~dirty_block_word_mask(word << 5, from, to);
+}
+
+static bool dirty_block_row_is_set(uint32 *row, int from, int to)
+{
+	for (int word = from >> 5; word <= to >> 5; word++) {
+		uint32 mask = dirty_block_word_mask(word << 5, from, to);
+		if ((row[word] & mask) != mask)
+			return false;
+	}
+	return true;
+}
+
 /**
  *
  *  rct2: 0x006E732D
@@ -232,8 +273,8 @@ uint8* gfx_get_dirty_blocks()
  */
 void gfx_set_dirty_blocks(sint16 left, sint16 top, sint16 right, sint16 bottom)
 {
-	int x, y;
-	uint8 *screenDirtyBlocks = gfx_get_dirty_blocks();
+	int y;
+	uint32 *screenDirtyBlocks = gfx_get_dirty_blocks();
 
 	left = max(left, 0);
 	top = max(top, 0);
@@ -253,12 +294,9 @@ void gfx_set_dirty_blocks(sint16 left, sint16 top, sint16 right, sint16 bottom)
 	top >>= _screenDirtyBlockShiftY;
 	bottom >>= _screenDirtyBlockShiftY;
 
-	uint32 dirtyBlockColumns = _screenDirtyBlockColumns;
+	uint32 rowWords = _screenDirtyBlockRowWords;
 	for (y = top; y <= bottom; y++) {
-		uint32 yOffset = y * dirtyBlockColumns;
-		for (x = left; x <= right; x++) {
-			screenDirtyBlocks[yOffset + x] = 0xFF;
-		}
+		dirty_block_row_set(&screenDirtyBlocks[y * rowWords], left, right);
 	}
 }
 
@@ -268,39 +306,37 @@ void gfx_set_dirty_blocks(sint16 left, sint16 top, sint16 right, sint16 bottom)
  */
 void gfx_draw_all_dirty_blocks()
 {
-	uint32 x, y, xx, yy, columns, rows;
+	uint32 y, yy, word, x, xx, rows;
 	uint32 dirtyBlockColumns = _screenDirtyBlockColumns;
 	uint32 dirtyBlockRows = _screenDirtyBlockRows;
-	uint8 *screenDirtyBlocks = gfx_get_dirty_blocks();
-
-	for (x = 0; x < dirtyBlockColumns; x++) {
-		for (y = 0; y < dirtyBlockRows; y++) {
-			uint32 yOffset = y * dirtyBlockColumns;
-			if (screenDirtyBlocks[yOffset + x] == 0) {
-				continue;
-			}
-
-			// Determine columns
-			for (xx = x; xx < dirtyBlockColumns; xx++) {
-				if (screenDirtyBlocks[yOffset + xx] == 0) {
-					break;
+	uint32 rowWords = _screenDirtyBlockRowWords;
+	uint32 *screenDirtyBlocks = gfx_get_dirty_blocks();
+
+	// Walk the rows in memory order, each run of dirty blocks in a row is grown downwards for as
+	// long as the rows below are dirty across the whole run, then drawn and cleared
+	for (y = 0; y < dirtyBlockRows; y++) {
+		uint32 *row = &screenDirtyBlocks[y * rowWords];
+		for (word = 0; word < rowWords; word++) {
+			while (row[word] != 0) {
+				x = (word << 5) + bitscanforward(row[word]);
+
+				// Determine columns
+				for (xx = x + 1; xx < dirtyBlockColumns; xx++) {
+					if (!(row[xx >> 5] & (1u << (xx & 31)))) {
+						break;
+					}
 				}
-			}
-			columns = xx - x;
-
-			// Check rows
-			for (yy = y; yy < dirtyBlockRows; yy++) {
-				uint32 yyOffset = yy * dirtyBlockColumns;
-				for (xx = x; xx < x + columns; xx++) {
-					if (screenDirtyBlocks[yyOffset + xx] == 0) {
-						goto endRowCheck;
+
+				// Check rows
+				for (yy = y + 1; yy < dirtyBlockRows; yy++) {
+					if (!dirty_block_row_is_set(&screenDirtyBlocks[yy * rowWords], x, xx - 1)) {
+						break;
 					}
 				}
-			}
+				rows = yy - y;
 
-		endRowCheck:
-			rows = yy - y;
-			gfx_draw_dirty_blocks(x, y, columns, rows);
+				gfx_draw_dirty_blocks(x, y, xx - x, rows);
+			}
 		}
 	}
 }
@@ -308,16 +344,14 @@ void gfx_draw_all_dirty_blocks()
 static void gfx_draw_dirty_blocks(int x, int y, int columns, int rows)
 {
 	uint32 left, top, right, bottom;
-	uint32 dirtyBlockColumns = _screenDirtyBlockColumns;
-	uint8 *screenDirtyBlocks = gfx_get_dirty_blocks();
+	uint32 rowWords = _screenDirtyBlockRowWords;
+	uint32 *screenDirtyBlocks = gfx_get_dirty_blocks();
 
 	// Unset dirty blocks
 	for (top = y; top < y + (uint32)rows; top++) {
-		uint32 topOffset = top * dirtyBlockColumns;
-		for (left = x; left < x + (uint32)columns; left++) {
-			screenDirtyBlocks[topOffset + left] = 0;
-		}
+		dirty_block_row_clear(&screenDirtyBlocks[top * rowWords], x, x + columns - 1);
 	}
+	gDirtyBlockRectsDrawn++;
 
 	// Determine region in pixels
 	left = max(0, x * _screenDirtyBlockWidth);
@@ -606,4 +640,5 @@ void gfx_configure_dirty_grid()
 	_screenDirtyBlockHeight = 1 << _screenDirtyBlockShiftY;
 	_screenDirtyBlockColumns = (gScreenWidth >> _screenDirtyBlockShiftX) + 1;
 	_screenDirtyBlockRows = (gScreenHeight >> _screenDirtyBlockShiftY) + 1;
+	_screenDirtyBlockRowWords = (_screenDirtyBlockColumns + 31) / 32;
 }
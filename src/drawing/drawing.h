@@ -96,6 +96,9 @@ extern uint8 text_palette[];
 extern int gLastDrawStringX;
 extern int gLastDrawStringY;
 
+// Number of dirty rectangles redrawn since it was last reset by window_update_all
+extern uint32 gDirtyBlockRectsDrawn;
+
 extern uint32 gPickupPeepImage;
 extern sint32 gPickupPeepX;
 extern sint32 gPickupPeepY;
@@ -200,7 +200,7 @@ void scrolling_text_set_bitmap_for_sprite(utf8 *text, int scroll, uint8 *bitmap,
 }
 
 TTFFontDescriptor *ttf_get_font_from_sprite_base(uint16 spriteBase);
-SDL_Surface *_ttf_surface_cache_get_or_add(TTF_Font *font, const utf8 *text);
+uint8 *ttf_render_string_bitmap(TTF_Font *font, const utf8 *text, int *outWidth, int *outHeight);
 
 void scrolling_text_set_bitmap_for_ttf(utf8 *text, int scroll, uint8 *bitmap, sint16 *scrollPositionOffsets)
 {
@@ -233,19 +233,14 @@ void scrolling_text_set_bitmap_for_ttf(utf8 *text, int scroll, uint8 *bitmap, si
 		colour = RCT2_GLOBAL(0x009FF048, uint8*)[(colour - FORMAT_COLOUR_CODE_START) * 4];
 	}
 
-	SDL_Surface *surface = _ttf_surface_cache_get_or_add(fontDesc->font, text);
-	if (surface == NULL) {
+	int width, height;
+	uint8 *src = ttf_render_string_bitmap(fontDesc->font, text, &width, &height);
+	if (src == NULL) {
 		return;
 	}
 
-	if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) == -1) {
-		return;
-	}
-
-	int pitch = surface->pitch;
-	int width = surface->w;
-	int height = surface->h;
-	uint8 *src = surface->pixels;
+	int pitch = width;
+	uint8 *srcOrig = src;
 
 	// Offset
 	height -= 3;
@@ -257,7 +252,7 @@ void scrolling_text_set_bitmap_for_ttf(utf8 *text, int scroll, uint8 *bitmap, si
 		// Skip any none displayed columns
 		if (scroll == 0) {
 			sint16 scrollPosition = *scrollPositionOffsets;
-			if (scrollPosition == -1) return;
+			if (scrollPosition == -1) break;
 			if (scrollPosition > -1) {
 				uint8 *dst = &bitmap[scrollPosition];
 
@@ -277,5 +272,5 @@ void scrolling_text_set_bitmap_for_ttf(utf8 *text, int scroll, uint8 *bitmap, si
 		if (x >= width) x = 0;
 	}
 
-	if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+	free(srcOrig);
 }
@@ -26,6 +26,8 @@
 #include "../openrct2.h"
 
 void *_g1Buffer = NULL;
+static void *_g1Mapping = NULL;
+static size_t _g1MappingSize = 0;
 
 rct_gx g2;
 
@@ -39,10 +41,35 @@ int gfx_load_g1()
 {
 	log_verbose("loading g1 graphics");
 
+	unsigned int startTicks = platform_get_ticks();
 	SDL_RWops *file;
 	rct_g1_header header;
 	unsigned int i;
 
+	// Map the file so element data is only paged in when a sprite is first drawn
+	_g1Mapping = platform_file_map(get_file_path(PATH_ID_G1), &_g1MappingSize);
+	if (_g1Mapping != NULL) {
+		size_t dataOffset = 8 + 29294 * sizeof(rct_g1_element);
+		if (_g1MappingSize >= dataOffset) {
+			memcpy(&header, _g1Mapping, 8);
+			header.num_entries = 29294;
+			if (_g1MappingSize - dataOffset >= header.total_size) {
+				memcpy(g1Elements, (uint8*)_g1Mapping + 8, header.num_entries * sizeof(rct_g1_element));
+				_g1Buffer = (uint8*)_g1Mapping + dataOffset;
+
+				// Fix entry data offsets
+				for (i = 0; i < header.num_entries; i++)
+					g1Elements[i].offset += (int)_g1Buffer;
+
+				log_verbose("mapped g1 graphics in %u ms", platform_get_ticks() - startTicks);
+				return 1;
+			}
+		}
+		platform_file_unmap(_g1Mapping, _g1MappingSize);
+		_g1Mapping = NULL;
+		_g1MappingSize = 0;
+	}
+
 	file = SDL_RWFromFile(get_file_path(PATH_ID_G1), "rb");
 	if (file != NULL) {
 		if (SDL_RWread(file, &header, 8, 1) == 1) {
@@ -63,6 +90,8 @@ int gfx_load_g1()
 			for (i = 0; i < header.num_entries; i++)
 				g1Elements[i].offset += (int)_g1Buffer;
 
+			log_verbose("loaded g1 graphics in %u ms", platform_get_ticks() - startTicks);
+
 			// Successful
 			return 1;
 		}
@@ -76,7 +105,14 @@ int gfx_load_g1()
 
 void gfx_unload_g1()
 {
-	SafeFree(_g1Buffer);
+	if (_g1Mapping != NULL) {
+		platform_file_unmap(_g1Mapping, _g1MappingSize);
+		_g1Mapping = NULL;
+		_g1MappingSize = 0;
+		_g1Buffer = NULL;
+	} else {
+		SafeFree(_g1Buffer);
+	}
 }
 
 void gfx_unload_g2()
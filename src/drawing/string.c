@@ -32,32 +32,31 @@ static void ttf_draw_string(rct_drawpixelinfo *dpi, char *buffer, int colour, in
 
 static bool _ttfInitialised = false;
 
-#define TTF_SURFACE_CACHE_SIZE 256
-#define TTF_GETWIDTH_CACHE_SIZE 1024
+#define TTF_GLYPH_CACHE_SIZE 4096
+#define TTF_GLYPH_ATLAS_WIDTH 1024
 
+// A glyph rasterised once into the shared 8-bit atlas, non-zero pixels are set
 typedef struct {
-	SDL_Surface *surface;
 	TTF_Font *font;
-	utf8 *text;
-	uint32 lastUseTick;
-} ttf_cache_entry;
-
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = { 0 };
-static int _ttfSurfaceCacheCount = 0;
-static int _ttfSurfaceCacheHitCount = 0;
-static int _ttfSurfaceCacheMissCount = 0;
-
-typedef struct {
-	uint32 width;
-	TTF_Font *font;
-	utf8 *text;
-	uint32 lastUseTick;
-} ttf_getwidth_cache_entry;
-
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = { 0 };
-static int _ttfGetWidthCacheCount = 0;
-static int _ttfGetWidthCacheHitCount = 0;
-static int _ttfGetWidthCacheMissCount = 0;
+	uint32 codepoint;
+	sint16 advance;
+	sint16 offset_x;
+	uint16 atlas_x;
+	uint16 atlas_y;
+	uint16 width;
+	uint16 height;
+} ttf_glyph_entry;
+
+static ttf_glyph_entry _ttfGlyphCache[TTF_GLYPH_CACHE_SIZE] = { 0 };
+static int _ttfGlyphCacheCount = 0;
+static int _ttfGlyphCacheHitCount = 0;
+static int _ttfGlyphCacheMissCount = 0;
+
+static uint8 *_ttfGlyphAtlas = NULL;
+static int _ttfGlyphAtlasHeight = 0;
+static int _ttfGlyphAtlasShelfX = 0;
+static int _ttfGlyphAtlasShelfY = 0;
+static int _ttfGlyphAtlasShelfHeight = 0;
 
 /**
  *
@@ -715,142 +714,207 @@ void gfx_draw_string_centred_wrapped_partial(rct_drawpixelinfo *dpi, int x, int
 	}
 }
 
-static uint32 _ttf_surface_cache_hash(TTF_Font *font, const utf8 *text)
+static uint32 _ttf_glyph_cache_hash(TTF_Font *font, uint32 codepoint)
 {
 	uint32 hash = ((uint32)font * 23) ^ 0xAAAAAAAA;
-	for (const utf8 *ch = text; *ch != 0; ch++) {
-		hash = ror32(hash, 3) ^ (*ch * 13);
-	}
+	hash = ror32(hash, 3) ^ (codepoint * 13);
+	hash = ror32(hash, 3) ^ (codepoint >> 8);
 	return hash;
 }
 
-static void _ttf_surface_cache_dispose(ttf_cache_entry *entry)
+static void _ttf_glyph_cache_dispose_all()
 {
-	if (entry->surface != NULL) {
-		SDL_FreeSurface(entry->surface);
-		free(entry->text);
+	memset(_ttfGlyphCache, 0, sizeof(_ttfGlyphCache));
+	_ttfGlyphCacheCount = 0;
 
-		entry->surface = NULL;
-		entry->font = NULL;
-		entry->text = NULL;
+	// Keep the atlas memory, just start packing from the top again
+	if (_ttfGlyphAtlas != NULL) {
+		memset(_ttfGlyphAtlas, 0, TTF_GLYPH_ATLAS_WIDTH * _ttfGlyphAtlasHeight);
 	}
+	_ttfGlyphAtlasShelfX = 0;
+	_ttfGlyphAtlasShelfY = 0;
+	_ttfGlyphAtlasShelfHeight = 0;
 }
 
-static void _ttf_surface_cache_dispose_all()
+/**
+ * Reserves a width x height region of the glyph atlas using simple shelf packing, growing the atlas if necessary.
+ */
+static bool _ttf_glyph_atlas_allocate(int width, int height, uint16 *outX, uint16 *outY)
 {
-	for (int i = 0; i < TTF_SURFACE_CACHE_SIZE; i++) {
-		_ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-		_ttfSurfaceCacheCount--;
+	if (_ttfGlyphAtlasShelfX + width > TTF_GLYPH_ATLAS_WIDTH) {
+		_ttfGlyphAtlasShelfY += _ttfGlyphAtlasShelfHeight;
+		_ttfGlyphAtlasShelfX = 0;
+		_ttfGlyphAtlasShelfHeight = 0;
 	}
-}
-
-SDL_Surface *_ttf_surface_cache_get_or_add(TTF_Font *font, const utf8 *text)
-{
-	ttf_cache_entry *entry;
-
-	uint32 hash = _ttf_surface_cache_hash(font, text);
-	int index = hash % TTF_SURFACE_CACHE_SIZE;
-	for (int i = 0; i < TTF_SURFACE_CACHE_SIZE; i++) {
-		entry = &_ttfSurfaceCache[index];
-
-		// Check if entry is a hit
-		if (entry->surface == NULL) break;
-		if (entry->font == font && strcmp(entry->text, text) == 0) {
-			_ttfSurfaceCacheHitCount++;
-			entry->lastUseTick = gCurrentDrawCount;
-			return entry->surface;
+	if (_ttfGlyphAtlasShelfY + height > _ttfGlyphAtlasHeight) {
+		int newHeight = max(max(64, _ttfGlyphAtlasHeight * 2), _ttfGlyphAtlasShelfY + height);
+		if (newHeight > UINT16_MAX) {
+			return false;
 		}
-
-		// If entry hasn't been used for a while, replace it
-		if (entry->lastUseTick < gCurrentDrawCount - 64) {
-			break;
+		uint8 *newAtlas = realloc(_ttfGlyphAtlas, TTF_GLYPH_ATLAS_WIDTH * newHeight);
+		if (newAtlas == NULL) {
+			return false;
 		}
+		memset(newAtlas + (TTF_GLYPH_ATLAS_WIDTH * _ttfGlyphAtlasHeight), 0, TTF_GLYPH_ATLAS_WIDTH * (newHeight - _ttfGlyphAtlasHeight));
+		_ttfGlyphAtlas = newAtlas;
+		_ttfGlyphAtlasHeight = newHeight;
+	}
 
-		// Check if next entry is a hit
-		if (++index >= TTF_SURFACE_CACHE_SIZE) index = 0;
+	*outX = _ttfGlyphAtlasShelfX;
+	*outY = _ttfGlyphAtlasShelfY;
+	_ttfGlyphAtlasShelfX += width;
+	_ttfGlyphAtlasShelfHeight = max(_ttfGlyphAtlasShelfHeight, height);
+	return true;
+}
+
+/**
+ * Rasterises a single codepoint the same way TTF_RenderUTF8_Solid would place it within a string and copies it
+ * into the atlas.
+ */
+static void _ttf_glyph_rasterise(ttf_glyph_entry *entry, TTF_Font *font, uint32 codepoint)
+{
+	entry->font = font;
+	entry->codepoint = codepoint;
+	entry->advance = 0;
+	entry->offset_x = 0;
+	entry->atlas_x = 0;
+	entry->atlas_y = 0;
+	entry->width = 0;
+	entry->height = 0;
+
+	int minX, maxX, minY, maxY, advance;
+	if (codepoint > UINT16_MAX || TTF_GlyphMetrics(font, (uint16)codepoint, &minX, &maxX, &minY, &maxY, &advance) != 0) {
+		return;
 	}
+	entry->advance = advance;
+	entry->offset_x = min(minX, 0);
 
-	// Cache miss, replace entry with new surface
-	entry = &_ttfSurfaceCache[index];
-	_ttf_surface_cache_dispose(entry);
+	utf8 buffer[8];
+	*utf8_write_codepoint(buffer, codepoint) = 0;
 
 	SDL_Color c = { 0, 0, 0, 255 };
-	SDL_Surface *surface = TTF_RenderUTF8_Solid(font, text, c);
+	SDL_Surface *surface = TTF_RenderUTF8_Solid(font, buffer, c);
 	if (surface == NULL) {
-		return NULL;
+		// Zero width glyphs such as spaces have no surface
+		return;
 	}
 
-	_ttfSurfaceCacheMissCount++;
-	// printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-	_ttfSurfaceCacheCount++;
-	entry->surface = surface;
-	entry->font = font;
-	entry->text = _strdup(text);
-	entry->lastUseTick = gCurrentDrawCount;
-	return entry->surface;
-}
-
-static void _ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry *entry)
-{
-	if (entry->text != NULL) {
-		free(entry->text);
+	if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) != 0) {
+		SDL_FreeSurface(surface);
+		return;
+	}
 
-		entry->width = 0;
-		entry->font = NULL;
-		entry->text = NULL;
+	int width = min(surface->w, TTF_GLYPH_ATLAS_WIDTH);
+	int height = surface->h;
+	if (_ttf_glyph_atlas_allocate(width, height, &entry->atlas_x, &entry->atlas_y)) {
+		entry->width = width;
+		entry->height = height;
+
+		const uint8 *src = surface->pixels;
+		uint8 *dst = &_ttfGlyphAtlas[entry->atlas_y * TTF_GLYPH_ATLAS_WIDTH + entry->atlas_x];
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				dst[x] = src[x] != 0;
+			}
+			src += surface->pitch;
+			dst += TTF_GLYPH_ATLAS_WIDTH;
+		}
 	}
-}
 
-static void _ttf_getwidth_cache_dispose_all()
-{
-	for (int i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++) {
-		_ttf_getwidth_cache_dispose(&_ttfGetWidthCache[i]);
-		_ttfGetWidthCacheCount--;
+	if (SDL_MUSTLOCK(surface)) {
+		SDL_UnlockSurface(surface);
 	}
+	SDL_FreeSurface(surface);
 }
 
-static uint32 _ttf_getwidth_cache_get_or_add(TTF_Font *font, const utf8 *text)
+static const ttf_glyph_entry *_ttf_glyph_cache_get_or_add(TTF_Font *font, uint32 codepoint)
 {
-	ttf_getwidth_cache_entry *entry;
+	ttf_glyph_entry *entry;
 
-	uint32 hash = _ttf_surface_cache_hash(font, text);
-	int index = hash % TTF_GETWIDTH_CACHE_SIZE;
-	for (int i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++) {
-		entry = &_ttfGetWidthCache[index];
+	uint32 hash = _ttf_glyph_cache_hash(font, codepoint);
+	int index = hash % TTF_GLYPH_CACHE_SIZE;
+	for (int i = 0; i < TTF_GLYPH_CACHE_SIZE; i++) {
+		entry = &_ttfGlyphCache[index];
 
 		// Check if entry is a hit
-		if (entry->text == NULL) break;
-		if (entry->font == font && strcmp(entry->text, text) == 0) {
-			_ttfGetWidthCacheHitCount++;
-			entry->lastUseTick = gCurrentDrawCount;
-			return entry->width;
-		}
-
-		// If entry hasn't been used for a while, replace it
-		if (entry->lastUseTick < gCurrentDrawCount - 64) {
-			break;
+		if (entry->font == NULL) break;
+		if (entry->font == font && entry->codepoint == codepoint) {
+			_ttfGlyphCacheHitCount++;
+			return entry;
 		}
 
 		// Check if next entry is a hit
-		if (++index >= TTF_GETWIDTH_CACHE_SIZE) index = 0;
+		if (++index >= TTF_GLYPH_CACHE_SIZE) index = 0;
 	}
 
-	// Cache miss, replace entry with new width
-	entry = &_ttfGetWidthCache[index];
-	_ttf_getwidth_cache_dispose(entry);
+	// Cache miss, start again if the table is getting too full to probe quickly
+	if (_ttfGlyphCacheCount >= (TTF_GLYPH_CACHE_SIZE * 3) / 4) {
+		_ttf_glyph_cache_dispose_all();
+		index = hash % TTF_GLYPH_CACHE_SIZE;
+	}
+	entry = &_ttfGlyphCache[index];
+	_ttf_glyph_rasterise(entry, font, codepoint);
 
-	int width, height;
-	TTF_SizeUTF8(font, text, &width, &height);
+	_ttfGlyphCacheMissCount++;
+	_ttfGlyphCacheCount++;
+	return entry;
+}
 
-	_ttfGetWidthCacheMissCount++;
+/**
+ * Measures a run of text from the cached glyph advances.
+ */
+static int _ttf_get_width(TTF_Font *font, const utf8 *text)
+{
+	const utf8 *ch = text;
+	int codepoint;
+	int x = 0;
+	int width = 0;
+	while ((codepoint = utf8_get_next(ch, &ch)) != 0) {
+		const ttf_glyph_entry *glyph = _ttf_glyph_cache_get_or_add(font, codepoint);
+		width = max(width, x + glyph->offset_x + glyph->width);
+		x += glyph->advance;
+	}
+	return max(width, x);
+}
 
-	_ttfGetWidthCacheCount++;
-	entry->width = width;
-	entry->font = font;
-	entry->text = _strdup(text);
-	entry->lastUseTick = gCurrentDrawCount;
-	return entry->width;
+/**
+ * Composes a run of text from the glyph atlas into a newly allocated 8-bit bitmap, non-zero pixels are set.
+ */
+uint8 *ttf_render_string_bitmap(TTF_Font *font, const utf8 *text, int *outWidth, int *outHeight)
+{
+	int width = _ttf_get_width(font, text);
+	int height = TTF_FontHeight(font);
+	if (width <= 0 || height <= 0) {
+		return NULL;
+	}
+
+	uint8 *bitmap = calloc(width * height, 1);
+	if (bitmap == NULL) {
+		return NULL;
+	}
+
+	const utf8 *ch = text;
+	int codepoint;
+	int x = 0;
+	while ((codepoint = utf8_get_next(ch, &ch)) != 0) {
+		const ttf_glyph_entry *glyph = _ttf_glyph_cache_get_or_add(font, codepoint);
+		const uint8 *src = &_ttfGlyphAtlas[glyph->atlas_y * TTF_GLYPH_ATLAS_WIDTH + glyph->atlas_x];
+		int glyphHeight = min((int)glyph->height, height);
+		for (int yy = 0; yy < glyphHeight; yy++) {
+			for (int xx = 0; xx < glyph->width; xx++) {
+				int dstX = x + glyph->offset_x + xx;
+				if (dstX >= 0 && dstX < width && src[xx] != 0) {
+					bitmap[yy * width + dstX] = 1;
+				}
+			}
+			src += TTF_GLYPH_ATLAS_WIDTH;
+		}
+		x += glyph->advance;
+	}
+
+	*outWidth = width;
+	*outHeight = height;
+	return bitmap;
 }
 
 bool ttf_initialise()
@@ -886,8 +950,9 @@ void ttf_dispose()
 	if (!_ttfInitialised)
 		return;
 
-	_ttf_surface_cache_dispose_all();
-	_ttf_getwidth_cache_dispose_all();
+	_ttf_glyph_cache_dispose_all();
+	SafeFree(_ttfGlyphAtlas);
+	_ttfGlyphAtlasHeight = 0;
 
 	for (int i = 0; i < 4; i++) {
 		TTFFontDescriptor *fontDesc = &(gCurrentTTFFontSet->size[i]);
@@ -957,6 +1022,80 @@ static void ttf_draw_string_raw_sprite(rct_drawpixelinfo *dpi, const utf8 *text,
 	};
 }
 
+static void ttf_draw_glyph(rct_drawpixelinfo *dpi, const ttf_glyph_entry *glyph, int drawX, int drawY, text_draw_info *info, bool outline)
+{
+	int width = glyph->width;
+	int height = glyph->height;
+	const uint8 *src = &_ttfGlyphAtlas[glyph->atlas_y * TTF_GLYPH_ATLAS_WIDTH + glyph->atlas_x];
+
+	int overflowX = (dpi->x + dpi->width) - (drawX + width);
+	int overflowY = (dpi->y + dpi->height) - (drawY + height);
+	if (overflowX < 0) width += overflowX;
+	if (overflowY < 0) height += overflowY;
+	int skipX = drawX - dpi->x;
+	int skipY = drawY - dpi->y;
+
+	if (skipX < 0) {
+		width += skipX;
+		src += -skipX;
+		skipX = 0;
+	}
+	if (skipY < 0) {
+		height += skipY;
+		src += (-skipY * TTF_GLYPH_ATLAS_WIDTH);
+		skipY = 0;
+	}
+	if (width <= 0 || height <= 0) {
+		return;
+	}
+
+	int dstPitch = dpi->width + dpi->pitch;
+	uint8 *dst = dpi->bits + skipX + (skipY * dstPitch);
+	uint8 colour = info->palette[1];
+	uint8 shadowColour = info->palette[3];
+
+	for (int yy = 0; yy < height; yy++) {
+		for (int xx = 0; xx < width; xx++) {
+			if (src[xx] == 0) {
+				continue;
+			}
+			if (outline) {
+				dst[xx + 1] = shadowColour; // right
+				dst[xx - 1] = shadowColour; // left
+				dst[xx - dstPitch] = shadowColour; // top
+				dst[xx + dstPitch] = shadowColour; // bottom
+			} else {
+				if (info->flags & TEXT_DRAW_FLAG_INSET) {
+					dst[xx + dstPitch + 1] = shadowColour;
+				}
+				dst[xx] = colour;
+			}
+		}
+		src += TTF_GLYPH_ATLAS_WIDTH;
+		dst += dstPitch;
+	}
+}
+
+/**
+ * Draws a run of text glyph by glyph from the atlas, returns the width of the run.
+ */
+static int ttf_draw_glyph_run(rct_drawpixelinfo *dpi, TTF_Font *font, const utf8 *text, int drawX, int drawY, text_draw_info *info, bool outline)
+{
+	const utf8 *ch = text;
+	int codepoint;
+	int x = 0;
+	int width = 0;
+	while ((codepoint = utf8_get_next(ch, &ch)) != 0) {
+		const ttf_glyph_entry *glyph = _ttf_glyph_cache_get_or_add(font, codepoint);
+		if (glyph->width != 0) {
+			ttf_draw_glyph(dpi, glyph, drawX + x + glyph->offset_x, drawY, info, outline);
+		}
+		width = max(width, x + glyph->offset_x + glyph->width);
+		x += glyph->advance;
+	}
+	return max(width, x);
+}
+
 static void ttf_draw_string_raw_ttf(rct_drawpixelinfo *dpi, const utf8 *text, text_draw_info *info)
 {
 	if (!_ttfInitialised && !ttf_initialise())
@@ -969,97 +1108,18 @@ static void ttf_draw_string_raw_ttf(rct_drawpixelinfo *dpi, const utf8 *text, te
 	}
 
 	if (info->flags & TEXT_DRAW_FLAG_NO_DRAW) {
-		info->x += _ttf_getwidth_cache_get_or_add(fontDesc->font, text);
+		info->x += _ttf_get_width(fontDesc->font, text);
 		return;
-	} else {
-		uint8 colour = info->palette[1];
-		SDL_Surface *surface = _ttf_surface_cache_get_or_add(fontDesc->font, text);
-		if (surface == NULL)
-			return;
-
-		if (SDL_MUSTLOCK(surface)) {
-			if (SDL_LockSurface(surface) != 0) {
-				return;
-			}
-		}
-
-		int fontSize = font_get_size_from_sprite_base(info->font_sprite_base);
-		int drawX = info->x + fontDesc->offset_x;
-		int drawY = info->y + fontDesc->offset_y;
-		int width = surface->w;
-		int height = surface->h;
-
-		int overflowX = (dpi->x + dpi->width) - (drawX + width);
-		int overflowY = (dpi->y + dpi->height) - (drawY + height);
-		if (overflowX < 0) width += overflowX;
-		if (overflowY < 0) height += overflowY;
-		int skipX = drawX - dpi->x;
-		int skipY = drawY - dpi->y;
-		info->x += width;
-
-		uint8 *src = surface->pixels;
-		uint8 *dst = dpi->bits;
-
-		if (skipX < 0) {
-			width += skipX;
-			src += -skipX;
-			skipX = 0;
-		}
-		if (skipY < 0) {
-			height += skipY;
-			src += (-skipY * surface->pitch);
-			skipY = 0;
-		}
+	}
 
-		dst += skipX;
-		dst += skipY * (dpi->width + dpi->pitch);
-
-		int srcScanSkip = surface->pitch - width;
-		int dstScanSkip = dpi->width + dpi->pitch - width;
-		uint8 *dst_orig = dst;
-		uint8 *src_orig = src;
-
-		// Draw shadow/outline
-		if (info->flags & TEXT_DRAW_FLAG_OUTLINE) {
-			for (int yy = 0; yy < height - 0; yy++) {
-				for (int xx = 0; xx < width - 0; xx++) {
-					if (*src != 0) {
-						*(dst + 1) = info->palette[3]; // right
-						*(dst - 1) = info->palette[3]; // left
-						*(dst - width - dstScanSkip) = info->palette[3]; // top
-						*(dst + width + dstScanSkip) = info->palette[3]; // bottom
-					}
-					src++;
-					dst++;
-				}
-				// Skip any remaining bits
-				src += srcScanSkip;
-				dst += dstScanSkip;
-			}
-		}
-		{
-			dst = dst_orig;
-			src = src_orig;
-			for (int yy = 0; yy < height; yy++) {
-				for (int xx = 0; xx < width; xx++) {
-					if (*src != 0) {
-						if (info->flags & TEXT_DRAW_FLAG_INSET) {
-							*(dst + width + dstScanSkip + 1) = info->palette[3];
-						}
-						*dst = colour;
-					}
-					src++;
-					dst++;
-				}
-				src += srcScanSkip;
-				dst += dstScanSkip;
-			}
-		}
+	int drawX = info->x + fontDesc->offset_x;
+	int drawY = info->y + fontDesc->offset_y;
 
-		if (SDL_MUSTLOCK(surface)) {
-			SDL_UnlockSurface(surface);
-		}
+	// The outline has to go down for the whole run first so that it does not overwrite neighbouring glyphs
+	if (info->flags & TEXT_DRAW_FLAG_OUTLINE) {
+		ttf_draw_glyph_run(dpi, fontDesc->font, text, drawX, drawY, info, true);
 	}
+	info->x += ttf_draw_glyph_run(dpi, fontDesc->font, text, drawX, drawY, info, false);
 }
 
 static void ttf_draw_string_raw(rct_drawpixelinfo *dpi, const utf8 *text, text_draw_info *info)
@@ -794,6 +794,7 @@ int game_load_sv6(SDL_RWops* rw)
 	reset_loaded_objects();
 	map_update_tile_pointers();
 	reset_0x69EBE4();
+	peep_invalidate_guest_histogram();
 	openrct2_reset_object_tween_locations();
 	game_convert_strings_to_utf8();
 	game_fix_save_vars(); // OpenRCT2 fix broken save games
@@ -910,6 +911,7 @@ int game_load_network(SDL_RWops* rw)
 	reset_loaded_objects();
 	map_update_tile_pointers();
 	reset_0x69EBE4();
+	peep_invalidate_guest_histogram();
 	openrct2_reset_object_tween_locations();
 	game_convert_strings_to_utf8();
 	gLastAutoSaveTick = SDL_GetTicks();
@@ -2368,18 +2368,26 @@ void viewport_paint_setup()
 	}
 }
 
-void sub_688217_helper(uint16 ax, uint8 flag)
+/**
+ * Sorts the paint structs of quadrant ax against those of the next quadrant. The search for the
+ * quadrant starts at ps_start, the node returned by the call for the previous quadrant. Every
+ * node before that belongs to an earlier quadrant and is never moved again, so this finds the
+ * same node as searching from the start of the list.
+ * @returns the node to start the search from for the next quadrant.
+ */
+static paint_struct *sub_688217_helper(paint_struct *ps_start, uint16 ax, uint8 flag)
 {
 	paint_struct *ps, *ps_temp;
-	paint_struct *ps_next = RCT2_GLOBAL(0x00EE7884, paint_struct*);
+	paint_struct *ps_next = ps_start;
 
 	do {
 		ps = ps_next;
 		ps_next = ps_next->next_quadrant_ps;
-		if (ps_next == NULL) return;
+		if (ps_next == NULL) return ps;
 	} while (ax > ps_next->var_18);
 
 	ps_temp = ps;
+	paint_struct *ps_quadrant_start = ps;
 
 	do {
 		ps = ps->next_quadrant_ps;
@@ -2400,8 +2408,8 @@ void sub_688217_helper(uint16 ax, uint8 flag)
 	while (true) {
 		while (true) {
 			ps_next = ps->next_quadrant_ps;
-			if (ps_next == NULL) return;
-			if (ps_next->var_1B & (1 << 7)) return;
+			if (ps_next == NULL) return ps_quadrant_start;
+			if (ps_next->var_1B & (1 << 7)) return ps_quadrant_start;
 			if (ps_next->var_1B & (1 << 0)) break;
 			ps = ps_next;
 		}
@@ -2488,12 +2496,12 @@ void sub_688217()
 
 	uint32 eax = RCT2_GLOBAL(0x00F1AD0C, uint32);
 
-	sub_688217_helper(eax & 0xFFFF, 1 << 1);
+	ps = sub_688217_helper(RCT2_GLOBAL(0x00EE7884, paint_struct*), eax & 0xFFFF, 1 << 1);
 
 	eax = RCT2_GLOBAL(0x00F1AD0C, uint32);
 
 	while (++eax < RCT2_GLOBAL(0x00F1AD10, uint32))
-		sub_688217_helper(eax & 0xFFFF, 0);
+		ps = sub_688217_helper(ps, eax & 0xFFFF, 0);
 }
 
 typedef struct paint_string_struct paint_string_struct;
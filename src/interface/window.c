@@ -174,6 +174,7 @@ void window_update_all()
 
 	RCT2_GLOBAL(0x009E3CD8, sint32)++;
 
+	gDirtyBlockRectsDrawn = 0;
 	gfx_draw_all_dirty_blocks();
 	window_update_all_viewports();
 	gfx_draw_all_dirty_blocks();
@@ -61,11 +61,18 @@ bool award_is_positive(int type)
 
 #pragma region Award checks
 
+/** Number of guests currently thinking about litter, disgusting paths or vandalism. */
+static int award_get_untidy_thought_count(const rct_guest_histogram *histogram)
+{
+	return
+		histogram->current_thoughts[PEEP_THOUGHT_TYPE_BAD_LITTER] +
+		histogram->current_thoughts[PEEP_THOUGHT_TYPE_PATH_DISGUSTING] +
+		histogram->current_thoughts[PEEP_THOUGHT_TYPE_VANDALISM];
+}
+
 /** More than 1/16 of the total guests must be thinking untidy thoughts. */
 static int award_is_deserved_most_untidy(int awardType, int activeAwardTypes)
 {
-	uint16 spriteIndex;
-	rct_peep *peep;
 	int negativeCount;
 
 	if (activeAwardTypes & (1 << PARK_AWARD_MOST_BEAUTIFUL))
@@ -75,30 +82,14 @@ static int award_is_deserved_most_untidy(int awardType, int activeAwardTypes)
 	if (activeAwardTypes & (1 << PARK_AWARD_MOST_TIDY))
 		return 0;
 
-	negativeCount = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-
-		if (peep->thoughts[0].var_2 > 5)
-			continue;
-
-		if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER ||
-			peep->thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING ||
-			peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM
-		) {
-			negativeCount++;
-		}
-	}
-
+	negativeCount = award_get_untidy_thought_count(peep_get_guest_histogram());
 	return (negativeCount > gNumGuestsInPark / 16);
 }
 
 /** More than 1/64 of the total guests must be thinking tidy thoughts and less than 6 guests thinking untidy thoughts. */
 static int award_is_deserved_most_tidy(int awardType, int activeAwardTypes)
 {
-	uint16 spriteIndex;
-	rct_peep *peep;
+	const rct_guest_histogram *histogram;
 	int positiveCount;
 	int negativeCount;
 
@@ -107,25 +98,9 @@ static int award_is_deserved_most_tidy(int awardType, int activeAwardTypes)
 	if (activeAwardTypes & (1 << PARK_AWARD_MOST_DISAPPOINTING))
 		return 0;
 
-	positiveCount = 0;
-	negativeCount = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-
-		if (peep->thoughts[0].var_2 > 5)
-			continue;
-
-		if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VERY_CLEAN)
-			positiveCount++;
-
-		if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER ||
-			peep->thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING ||
-			peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM
-		) {
-			negativeCount++;
-		}
-	}
+	histogram = peep_get_guest_histogram();
+	positiveCount = histogram->current_thoughts[PEEP_THOUGHT_TYPE_VERY_CLEAN];
+	negativeCount = award_get_untidy_thought_count(histogram);
 
 	return (negativeCount <= 5 && positiveCount > gNumGuestsInPark / 64);
 }
@@ -174,8 +149,7 @@ static int award_is_deserved_best_value(int awardType, int activeAwardTypes)
 /** More than 1/128 of the total guests must be thinking scenic thoughts and less than 16 untidy thoughts. */
 static int award_is_deserved_most_beautiful(int awardType, int activeAwardTypes)
 {
-	uint16 spriteIndex;
-	rct_peep *peep;
+	const rct_guest_histogram *histogram;
 	int positiveCount;
 	int negativeCount;
 
@@ -184,25 +158,9 @@ static int award_is_deserved_most_beautiful(int awardType, int activeAwardTypes)
 	if (activeAwardTypes & (1 << PARK_AWARD_MOST_DISAPPOINTING))
 		return 0;
 
-	positiveCount = 0;
-	negativeCount = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-
-		if (peep->thoughts[0].var_2 > 5)
-			continue;
-
-		if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_SCENERY)
-			positiveCount++;
-
-		if (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BAD_LITTER ||
-			peep->thoughts[0].type == PEEP_THOUGHT_TYPE_PATH_DISGUSTING ||
-			peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM
-		) {
-			negativeCount++;
-		}
-	}
+	histogram = peep_get_guest_histogram();
+	positiveCount = histogram->current_thoughts[PEEP_THOUGHT_TYPE_SCENERY];
+	negativeCount = award_get_untidy_thought_count(histogram);
 
 	return (negativeCount <= 15 && positiveCount > gNumGuestsInPark / 128);
 }
@@ -225,17 +183,9 @@ static int award_is_deserved_worse_value(int awardType, int activeAwardTypes)
 static int award_is_deserved_safest(int awardType, int activeAwardTypes)
 {
 	int i, peepsWhoDislikeVandalism;
-	uint16 spriteIndex;
-	rct_peep *peep;
 	rct_ride *ride;
 
-	peepsWhoDislikeVandalism = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-		if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_VANDALISM)
-			peepsWhoDislikeVandalism++;
-	}
+	peepsWhoDislikeVandalism = peep_get_guest_histogram()->current_thoughts[PEEP_THOUGHT_TYPE_VANDALISM];
 
 	if (peepsWhoDislikeVandalism > 2)
 		return 0;
@@ -282,8 +232,6 @@ static int award_is_deserved_best_food(int awardType, int activeAwardTypes)
 	uint64 shopTypes;
 	rct_ride *ride;
 	rct_ride_entry *rideType;
-	uint16 spriteIndex;
-	rct_peep *peep;
 
 	if (activeAwardTypes & (1 << PARK_AWARD_WORST_FOOD))
 		return 0;
@@ -312,14 +260,7 @@ static int award_is_deserved_best_food(int awardType, int activeAwardTypes)
 		return 0;
 
 	// Count hungry peeps
-	hungryPeeps = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-
-		if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_HUNGRY)
-			hungryPeeps++;
-	}
+	hungryPeeps = peep_get_guest_histogram()->current_thoughts[PEEP_THOUGHT_TYPE_HUNGRY];
 
 	return (hungryPeeps <= 12);
 }
@@ -331,8 +272,6 @@ static int award_is_deserved_worst_food(int awardType, int activeAwardTypes)
 	uint64 shopTypes;
 	rct_ride *ride;
 	rct_ride_entry *rideType;
-	uint16 spriteIndex;
-	rct_peep *peep;
 
 	if (activeAwardTypes & (1 << PARK_AWARD_BEST_FOOD))
 		return 0;
@@ -361,14 +300,7 @@ static int award_is_deserved_worst_food(int awardType, int activeAwardTypes)
 		return 0;
 
 	// Count hungry peeps
-	hungryPeeps = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-
-		if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_HUNGRY)
-			hungryPeeps++;
-	}
+	hungryPeeps = peep_get_guest_histogram()->current_thoughts[PEEP_THOUGHT_TYPE_HUNGRY];
 
 	return (hungryPeeps > 15);
 }
@@ -378,8 +310,6 @@ static int award_is_deserved_best_restrooms(int awardType, int activeAwardTypes)
 {
 	unsigned int i, numRestrooms, guestsWhoNeedRestroom;
 	rct_ride *ride;
-	uint16 spriteIndex;
-	rct_peep *peep;
 
 	// Count open restrooms
 	numRestrooms = 0;
@@ -396,14 +326,7 @@ static int award_is_deserved_best_restrooms(int awardType, int activeAwardTypes)
 		return 0;
 
 	// Count number of guests who are thinking they need the restroom
-	guestsWhoNeedRestroom = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-
-		if (peep->thoughts[0].var_2 <= 5 && peep->thoughts[0].type == PEEP_THOUGHT_TYPE_BATHROOM)
-			guestsWhoNeedRestroom++;
-	}
+	guestsWhoNeedRestroom = peep_get_guest_histogram()->current_thoughts[PEEP_THOUGHT_TYPE_BATHROOM];
 
 	return (guestsWhoNeedRestroom <= 16);
 }
@@ -524,19 +447,11 @@ static int award_is_deserved_most_dazzling_ride_colours(int awardType, int activ
 static int award_is_deserved_most_confusing_layout(int awardType, int activeAwardTypes)
 {
 	unsigned int peepsCounted, peepsLost;
-	uint16 spriteIndex;
-	rct_peep *peep;
+	const rct_guest_histogram *histogram;
 
-	peepsCounted = 0;
-	peepsLost = 0;
-	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0)
-			continue;
-
-		peepsCounted++;
-		if (peep->thoughts[0].var_2 <= 5 && (peep->thoughts[0].type == PEEP_THOUGHT_TYPE_LOST || peep->thoughts[0].type == PEEP_THOUGHT_TYPE_CANT_FIND))
-			peepsLost++;
-	}
+	histogram = peep_get_guest_histogram();
+	peepsCounted = histogram->guests;
+	peepsLost = histogram->current_thoughts[PEEP_THOUGHT_TYPE_LOST] + histogram->current_thoughts[PEEP_THOUGHT_TYPE_CANT_FIND];
 
 	return (peepsLost >= 10 && peepsLost >= peepsCounted / 64);
 }
@@ -32,7 +32,7 @@
 #include "world/scenery.h"
 #include "world/water.h"
 
-#define FILTER_VERSION 1
+#define FILTER_VERSION 2
 
 typedef struct {
 	uint32 total_files;
@@ -42,6 +42,22 @@ typedef struct {
 	uint32 object_list_no_items;
 } rct_plugin_header;
 
+// Size and modification date of the file each installed object was read from
+typedef struct {
+	uint64 size;
+	uint64 last_modified;
+} rct_object_file_record;
+
+// Installed objects from the previous scan, looked up by file name
+typedef struct {
+	rct_object_entry **entries;
+	rct_object_filters *filters;
+	rct_object_file_record *file_records;
+	uint32 count;
+	sint32 *path_hash_table;
+	uint32 path_hash_table_size;
+} object_list_previous;
+
 // 98DA00
 int object_entry_group_counts[] = {
 	128,	// rides
@@ -97,6 +113,7 @@ static uint32 install_object_entry(rct_object_entry* entry, rct_object_entry* in
 static void load_object_filter(rct_object_entry* entry, uint8* chunk, rct_object_filters* filter);
 
 static rct_object_filters *_installedObjectFilters = NULL;
+static rct_object_file_record *_installedObjectFileRecords = NULL;
 
 uint32 gInstalledObjectsCount;
 rct_object_entry *gInstalledObjects;
@@ -111,65 +128,77 @@ static void get_plugin_path(utf8 *outPath)
 	strcat(outPath, "plugin.dat");
 }
 
+typedef struct {
+	rct_object_entry *entry;
+	const char *name;
+	int index;
+} object_list_sort_item;
+
+static int object_list_sort_compare(const void *a, const void *b)
+{
+	const object_list_sort_item *itemA = (const object_list_sort_item*)a;
+	const object_list_sort_item *itemB = (const object_list_sort_item*)b;
+
+	// Keep the original order for objects with the same name
+	int result = strcmp(itemA->name, itemB->name);
+	return result != 0 ? result : itemA->index - itemB->index;
+}
+
 static void object_list_sort()
 {
-	rct_object_entry **objectBuffer, *newBuffer, *entry, *destEntry, *lowestEntry = NULL;
-	rct_object_filters *newFilters = NULL, *destFilter = NULL;
-	int numObjects, i, j, bufferSize, entrySize, lowestIndex = 0;
-	char *objectName, *lowestString;
-	uint8 *copied;
+	rct_object_entry *newBuffer, *entry, *destEntry;
+	rct_object_filters *newFilters = NULL;
+	rct_object_file_record *newFileRecords = NULL;
+	object_list_sort_item *items;
+	int numObjects, i, bufferSize, entrySize;
 
-	objectBuffer = &gInstalledObjects;
 	numObjects = gInstalledObjectsCount;
-	copied = calloc(numObjects, sizeof(uint8));
+	items = malloc(numObjects * sizeof(object_list_sort_item));
 
-	// Get buffer size
-	entry = *objectBuffer;
-	for (i = 0; i < numObjects; i++)
+	// Get buffer size and object names
+	entry = gInstalledObjects;
+	for (i = 0; i < numObjects; i++) {
+		items[i].entry = entry;
+		items[i].name = object_get_name(entry);
+		items[i].index = i;
 		entry = object_get_next(entry);
-	bufferSize = (int)entry - (int)*objectBuffer;
+	}
+	bufferSize = (int)entry - (int)gInstalledObjects;
+
+	qsort(items, numObjects, sizeof(object_list_sort_item), object_list_sort_compare);
 
 	// Create new buffer
 	newBuffer = (rct_object_entry*)malloc(bufferSize);
 	destEntry = newBuffer;
-	if (_installedObjectFilters) {
+	if (_installedObjectFilters)
 		newFilters = malloc(numObjects * sizeof(rct_object_filters));
-		destFilter = newFilters;
-	}
+	if (_installedObjectFileRecords)
+		newFileRecords = malloc(numObjects * sizeof(rct_object_file_record));
 
 	// Copy over sorted objects
 	for (i = 0; i < numObjects; i++) {
-		// Find next lowest string
-		lowestString = NULL;
-		entry = *objectBuffer;
-		for (j = 0; j < numObjects; j++) {
-			if (!copied[j]) {
-				objectName = object_get_name(entry);
-				if (lowestString == NULL || strcmp(objectName, lowestString) < 0) {
-					lowestEntry = entry;
-					lowestString = objectName;
-					lowestIndex = j;
-				}
-			}
-			entry = object_get_next(entry);
-		}
-		entrySize = object_get_length(lowestEntry);
-		memcpy(destEntry, lowestEntry, entrySize);
+		entrySize = object_get_length(items[i].entry);
+		memcpy(destEntry, items[i].entry, entrySize);
 		destEntry = (rct_object_entry*)((int)destEntry + entrySize);
 		if (_installedObjectFilters)
-			destFilter[i] = _installedObjectFilters[lowestIndex];
-		copied[lowestIndex] = 1;
+			newFilters[i] = _installedObjectFilters[items[i].index];
+		if (_installedObjectFileRecords)
+			newFileRecords[i] = _installedObjectFileRecords[items[i].index];
 	}
 
 	// Replace old buffer
-	free(*objectBuffer);
-	*objectBuffer = newBuffer;
+	free(gInstalledObjects);
+	gInstalledObjects = newBuffer;
 	if (_installedObjectFilters) {
 		free(_installedObjectFilters);
 		_installedObjectFilters = newFilters;
 	}
+	if (_installedObjectFileRecords) {
+		free(_installedObjectFileRecords);
+		_installedObjectFileRecords = newFileRecords;
+	}
 
-	free(copied);
+	free(items);
 }
 
 static uint32 object_list_count_custom_objects()
@@ -248,6 +277,111 @@ static int object_list_query_directory(int *outTotalFiles, uint64 *outTotalFileS
 	return 1;
 }
 
+static uint32 object_get_path_hash_code(const char *path)
+{
+	uint32 hash = 5381;
+	while (*path != '\0')
+		hash = ((hash << 5) + hash) + (uint8)*path++;
+
+	return hash;
+}
+
+static const char *object_get_path(rct_object_entry *entry)
+{
+	return (char*)entry + sizeof(rct_object_entry);
+}
+
+/**
+ * Takes ownership of the current installed object list so that the entries of files that have not changed can be
+ * reused by the next scan rather than loading every object again.
+ */
+static void object_list_previous_begin(object_list_previous *previous)
+{
+	rct_object_entry *entry;
+
+	memset(previous, 0, sizeof(object_list_previous));
+
+	// Without file records there is no way to tell whether a file has changed
+	if (gInstalledObjects == NULL || _installedObjectFilters == NULL || _installedObjectFileRecords == NULL) {
+		return;
+	}
+
+	previous->count = gInstalledObjectsCount;
+	previous->filters = _installedObjectFilters;
+	previous->file_records = _installedObjectFileRecords;
+	previous->entries = malloc(previous->count * sizeof(rct_object_entry*));
+	previous->path_hash_table_size = max(8192, previous->count * 4);
+	previous->path_hash_table = malloc(previous->path_hash_table_size * sizeof(sint32));
+	memset(previous->path_hash_table, 0xFF, previous->path_hash_table_size * sizeof(sint32));
+
+	entry = gInstalledObjects;
+	for (uint32 i = 0; i < previous->count; i++) {
+		previous->entries[i] = entry;
+
+		uint32 index = object_get_path_hash_code(object_get_path(entry)) % previous->path_hash_table_size;
+		while (previous->path_hash_table[index] != -1) {
+			index++;
+			if (index >= previous->path_hash_table_size) index = 0;
+		}
+		previous->path_hash_table[index] = i;
+
+		entry = object_get_next(entry);
+	}
+
+	// The entries are still referenced by the previous list, so the buffer is freed with it
+	_installedObjectFilters = NULL;
+	_installedObjectFileRecords = NULL;
+}
+
+static void object_list_previous_end(object_list_previous *previous, rct_object_entry *previousObjects)
+{
+	SafeFree(previous->entries);
+	SafeFree(previous->path_hash_table);
+	SafeFree(previous->filters);
+	SafeFree(previous->file_records);
+	SafeFree(previousObjects);
+}
+
+/**
+ * Copies the installed entry of a file from the previous scan if the file has not been modified since.
+ * Returns the size of the new entry or 0 if the file has to be loaded again.
+ */
+static uint32 object_list_previous_reuse(object_list_previous *previous, const file_info *fileInfo, rct_object_entry *installedEntry, rct_object_filters *filter)
+{
+	if (previous->count == 0) {
+		return 0;
+	}
+
+	uint32 index = object_get_path_hash_code(fileInfo->path) % previous->path_hash_table_size;
+	while (previous->path_hash_table[index] != -1) {
+		sint32 objectIndex = previous->path_hash_table[index];
+		rct_object_entry *entry = previous->entries[objectIndex];
+		if (strcmp(object_get_path(entry), fileInfo->path) == 0) {
+			rct_object_file_record *fileRecord = &previous->file_records[objectIndex];
+			if (fileRecord->size != fileInfo->size || fileRecord->last_modified != fileInfo->last_modified) {
+				return 0;
+			}
+
+			if ((entry->flags & 0xF0) == 0x80) {
+				if (gNumInstalledRCT2Objects >= 772) {
+					return 0;
+				}
+				gNumInstalledRCT2Objects++;
+			}
+
+			uint32 entrySize = object_get_length(entry);
+			memcpy(installedEntry, entry, entrySize);
+			*filter = previous->filters[objectIndex];
+			gInstalledObjectsCount++;
+			return entrySize;
+		}
+
+		index++;
+		if (index >= previous->path_hash_table_size) index = 0;
+	}
+	return 0;
+}
+
 /**
  *
  *  rct2: 0x006A8B40
@@ -257,6 +391,8 @@ void object_list_load()
 	int enumFileHandle, totalFiles, fileDateModifiedChecksum;
 	uint64 totalFileSize;
 	file_info enumFileInfo;
+	object_list_previous previous;
+	rct_object_entry *previousObjects;
 
 	int ok = object_list_query_directory(&totalFiles, &totalFileSize, &fileDateModifiedChecksum);
 	if (ok != 1) {
@@ -272,13 +408,21 @@ void object_list_load()
 		return;
 	}
 
-	// Dispose installed object list
+	// Dispose installed object list, keeping the entries of the previous scan for unchanged files
 	reset_loaded_objects();
-	SafeFree(gInstalledObjects);
-
+	object_list_previous_begin(&previous);
+	previousObjects = gInstalledObjects;
+	gInstalledObjects = NULL;
+	SafeFree(_installedObjectFilters);
+	SafeFree(_installedObjectFileRecords);
+
+	size_t installedObjectsCapacity = 4096;
+	size_t objectsCapacity = 256;
 	gInstalledObjectsCount = 0;
-	gInstalledObjects = (rct_object_entry*)malloc(4096);
-	if (gInstalledObjects == NULL) {
+	gInstalledObjects = (rct_object_entry*)malloc(installedObjectsCapacity);
+	_installedObjectFilters = malloc(objectsCapacity * sizeof(rct_object_filters));
+	_installedObjectFileRecords = malloc(objectsCapacity * sizeof(rct_object_file_record));
+	if (gInstalledObjects == NULL || _installedObjectFilters == NULL || _installedObjectFileRecords == NULL) {
 		log_error("Failed to allocate memory for object list");
 		rct2_exit_reason(835, 3162);
 		return;
@@ -286,24 +430,20 @@ void object_list_load()
 
 	uint32 fileCount = 0;
 	uint32 objectCount = 0;
+	uint32 reusedObjectCount = 0;
 	size_t currentEntryOffset = 0;
 	gNumInstalledRCT2Objects = 0;
 
 	log_verbose("building cache of available objects...");
 
-	if (_installedObjectFilters) {
-		free(_installedObjectFilters);
-		_installedObjectFilters = NULL;
-	}
-
 	enumFileHandle = platform_enumerate_files_begin(RCT2_ADDRESS(RCT2_ADDRESS_OBJECT_DATA_PATH, char));
 	if (enumFileHandle != INVALID_HANDLE) {
-		size_t installedObjectsCapacity = 4096;
 		while (platform_enumerate_files_next(enumFileHandle, &enumFileInfo)) {
 			fileCount++;
 
+			// Grow the buffers geometrically rather than for every object
 			if ((installedObjectsCapacity - currentEntryOffset) <= 2842){
-				installedObjectsCapacity += 4096;
+				installedObjectsCapacity *= 2;
 				gInstalledObjects = (rct_object_entry*)realloc(gInstalledObjects, installedObjectsCapacity);
 				if (gInstalledObjects == NULL) {
 					log_error("Failed to allocate memory for object list");
@@ -311,27 +451,47 @@ void object_list_load()
 					return;
 				}
 			}
+			if (objectCount >= objectsCapacity) {
+				objectsCapacity *= 2;
+				_installedObjectFilters = realloc(_installedObjectFilters, objectsCapacity * sizeof(rct_object_filters));
+				_installedObjectFileRecords = realloc(_installedObjectFileRecords, objectsCapacity * sizeof(rct_object_file_record));
+				if (_installedObjectFilters == NULL || _installedObjectFileRecords == NULL) {
+					log_error("Failed to allocate memory for object list");
+					rct2_exit_reason(835, 3162);
+					return;
+				}
+			}
 
-			char path[MAX_PATH];
-			substitute_path(path, RCT2_ADDRESS(RCT2_ADDRESS_OBJECT_DATA_PATH, char), enumFileInfo.path);
-
-			rct_object_entry entry;
-			if (object_load_entry(path, &entry)) {
-				_installedObjectFilters = realloc(_installedObjectFilters, sizeof(rct_object_filters) * (objectCount + 1));
+			rct_object_entry *installedEntry = (rct_object_entry*)((size_t)gInstalledObjects + currentEntryOffset);
+			rct_object_filters filter;
+			size_t newEntrySize = object_list_previous_reuse(&previous, &enumFileInfo, installedEntry, &filter);
+			if (newEntrySize != 0) {
+				reusedObjectCount++;
+			} else {
+				char path[MAX_PATH];
+				substitute_path(path, RCT2_ADDRESS(RCT2_ADDRESS_OBJECT_DATA_PATH, char), enumFileInfo.path);
 
-				rct_object_entry *installedEntry = (rct_object_entry*)((size_t)gInstalledObjects + currentEntryOffset);
-				rct_object_filters filter;
-				size_t newEntrySize = install_object_entry(&entry, installedEntry, enumFileInfo.path, &filter);
-				if (newEntrySize != 0) {
-					_installedObjectFilters[objectCount] = filter;
-					objectCount++;
-					currentEntryOffset += newEntrySize;
+				rct_object_entry entry;
+				if (object_load_entry(path, &entry)) {
+					newEntrySize = install_object_entry(&entry, installedEntry, enumFileInfo.path, &filter);
 				}
 			}
+
+			if (newEntrySize != 0) {
+				_installedObjectFilters[objectCount] = filter;
+				_installedObjectFileRecords[objectCount].size = enumFileInfo.size;
+				_installedObjectFileRecords[objectCount].last_modified = enumFileInfo.last_modified;
+				objectCount++;
+				currentEntryOffset += newEntrySize;
+			}
 		}
 		platform_enumerate_files_end(enumFileHandle);
 	}
 
+	object_list_previous_end(&previous, previousObjects);
+
+	log_verbose("%u objects unchanged, %u objects loaded", reusedObjectCount, objectCount - reusedObjectCount);
+
 	reset_loaded_objects();
 
 	object_list_cache_save(fileCount, totalFileSize, fileDateModifiedChecksum, currentEntryOffset);
@@ -345,12 +505,53 @@ void object_list_load()
 	object_list_examine();
 }
 
+/**
+ * Reads the installed object list, filters and file records of the cache into the current object list.
+ */
+static bool object_list_cache_read_objects(SDL_RWops *file, const rct_plugin_header *pluginHeader)
+{
+	uint32 filterVersion = 0;
+
+	// Dispose installed object list
+	SafeFree(gInstalledObjects);
+	SafeFree(_installedObjectFilters);
+	SafeFree(_installedObjectFileRecords);
+	gInstalledObjectsCount = 0;
+
+	// Read installed object list
+	gInstalledObjects = (rct_object_entry*)malloc(pluginHeader->object_list_size);
+	if (SDL_RWread(file, gInstalledObjects, pluginHeader->object_list_size, 1) != 1) {
+		return false;
+	}
+	gInstalledObjectsCount = pluginHeader->object_list_no_items;
+
+	if (pluginHeader->object_list_no_items != (pluginHeader->total_files & 0xFFFFFF))
+		log_error("Potential mismatch in file numbers. Possible corrupt file. Consider deleting plugin.dat.");
+
+	if (SDL_RWread(file, &filterVersion, sizeof(filterVersion), 1) != 1 || filterVersion != FILTER_VERSION) {
+		log_info("Filter version updated... updating object list cache");
+		return false;
+	}
+
+	_installedObjectFilters = malloc(sizeof(rct_object_filters) * pluginHeader->object_list_no_items);
+	if (SDL_RWread(file, _installedObjectFilters, sizeof(rct_object_filters) * pluginHeader->object_list_no_items, 1) != 1) {
+		SafeFree(_installedObjectFilters);
+		return false;
+	}
+
+	_installedObjectFileRecords = malloc(sizeof(rct_object_file_record) * pluginHeader->object_list_no_items);
+	if (SDL_RWread(file, _installedObjectFileRecords, sizeof(rct_object_file_record) * pluginHeader->object_list_no_items, 1) != 1) {
+		SafeFree(_installedObjectFileRecords);
+		return false;
+	}
+	return true;
+}
+
 static int object_list_cache_load(int totalFiles, uint64 totalFileSize, int fileDateModifiedChecksum)
 {
 	char path[MAX_PATH];
 	SDL_RWops *file;
 	rct_plugin_header pluginHeader;
-	uint32 filterVersion = 0;
 
 	log_verbose("loading object list cache (plugin.dat)");
 
@@ -368,33 +569,14 @@ static int object_list_cache_load(int totalFiles, uint64 totalFileSize, int file
 			pluginHeader.total_file_size == totalFileSize &&
 			pluginHeader.date_modified_checksum == fileDateModifiedChecksum
 		) {
-			// Dispose installed object list
-			SafeFree(gInstalledObjects);
-
-			// Read installed object list
-			gInstalledObjects = (rct_object_entry*)malloc(pluginHeader.object_list_size);
-			if (SDL_RWread(file, gInstalledObjects, pluginHeader.object_list_size, 1) == 1) {
-				gInstalledObjectsCount = pluginHeader.object_list_no_items;
-
-				if (pluginHeader.object_list_no_items != (pluginHeader.total_files & 0xFFFFFF))
-					log_error("Potential mismatch in file numbers. Possible corrupt file. Consider deleting plugin.dat.");
-
-				if (SDL_RWread(file, &filterVersion, sizeof(filterVersion), 1) == 1) {
-					if (filterVersion == FILTER_VERSION) {
-						if (_installedObjectFilters != NULL) {
-							free(_installedObjectFilters);
-						}
-						_installedObjectFilters = malloc(sizeof(rct_object_filters) * pluginHeader.object_list_no_items);
-						if (SDL_RWread(file, _installedObjectFilters, sizeof(rct_object_filters) * pluginHeader.object_list_no_items, 1) == 1) {
-							SDL_RWclose(file);
-							reset_loaded_objects();
-							object_list_examine();
-							return 1;
-						}
-					}
-				}
-				log_info("Filter version updated... updating object list cache");
+			if (object_list_cache_read_objects(file, &pluginHeader)) {
+				SDL_RWclose(file);
+				reset_loaded_objects();
+				object_list_examine();
+				return 1;
 			}
+			SDL_RWclose(file);
+			return 0;
 		}
 		else if (pluginHeader.total_files != totalFiles) {
 			int fileCount = totalFiles - pluginHeader.total_files;
@@ -409,6 +591,8 @@ static int object_list_cache_load(int totalFiles, uint64 totalFileSize, int file
 			log_info("Objects files have been updated... updating object list cache");
 		}
 
+		// Read the outdated object list anyway so that only the changed files have to be loaded again
+		object_list_cache_read_objects(file, &pluginHeader);
 		SDL_RWclose(file);
 		return 0;
 	}
@@ -445,6 +629,7 @@ static int object_list_cache_save(int fileCount, uint64 totalFileSize, int fileD
 	SDL_RWwrite(file, gInstalledObjects, pluginHeader.object_list_size, 1);
 	SDL_RWwrite(file, &filterVersion, sizeof(filterVersion), 1);
 	SDL_RWwrite(file, _installedObjectFilters, sizeof(rct_object_filters) * gInstalledObjectsCount, 1);
+	SDL_RWwrite(file, _installedObjectFileRecords, sizeof(rct_object_file_record) * gInstalledObjectsCount, 1);
 	SDL_RWclose(file);
 	return 1;
 }
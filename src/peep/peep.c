@@ -159,24 +159,94 @@ int peep_get_staff_count()
 	return count;
 }
 
+// Rated rides in the order peep_pick_ride_to_go_on prefers them, rebuilt once per peep_update_all
+static uint8 _rideExcitementOrder[MAX_RIDES];
+static int _rideExcitementOrderCount;
+static bool _rideExcitementOrderValid = false;
+
+static rct_guest_histogram _guestHistogram;
+static uint32 _guestHistogramTick;
+static bool _guestHistogramValid = false;
+
+void peep_invalidate_guest_histogram()
+{
+	_guestHistogramValid = false;
+}
+
+/**
+ * Gets the guest histogram, rescanning the guest list at most once per tick.
+ */
+const rct_guest_histogram *peep_get_guest_histogram()
+{
+	uint16 spriteIndex;
+	rct_peep *peep;
+
+	if (_guestHistogramValid && _guestHistogramTick == gCurrentTicks)
+		return &_guestHistogram;
+
+	rct_guest_histogram *histogram = &_guestHistogram;
+	memset(histogram, 0, sizeof(rct_guest_histogram));
+	FOR_ALL_GUESTS(spriteIndex, peep) {
+		if (peep->outside_of_park != 0)
+			continue;
+
+		histogram->guests++;
+		if (peep->happiness > 128)
+			histogram->happy_guests++;
+		if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
+			histogram->lost_guests++;
+		if (peep->thoughts[0].var_2 <= PEEP_THOUGHT_CURRENT_AGE)
+			histogram->current_thoughts[peep->thoughts[0].type]++;
+	}
+
+	_guestHistogramTick = gCurrentTicks;
+	_guestHistogramValid = true;
+	return histogram;
+}
+
+// Number of peeps ahead of the current one whose sprite records are prefetched
+#define PEEP_UPDATE_PREFETCH_DISTANCE 4
+
+static uint16 _peepUpdateOrder[MAX_SPRITES];
+
 /**
  *
  *  rct2: 0x0068F0A9
  */
 void peep_update_all()
 {
-	int i;
+	int i, count;
 	uint16 spriteIndex;
 	rct_peep* peep;
 
 	if (gScreenFlags & 0x0E)
 		return;
 
+	peep_invalidate_guest_histogram();
+	_rideExcitementOrderValid = false;
+
+	// Flatten the peep list first so the records further along it can be
+	// prefetched, the list order has no relation to the order in memory
+	count = 0;
 	spriteIndex = RCT2_GLOBAL(RCT2_ADDRESS_SPRITES_START_PEEP, uint16);
-	i = 0;
-	while (spriteIndex != SPRITE_INDEX_NULL) {
-		peep = &(g_sprite_list[spriteIndex].peep);
-		spriteIndex = peep->next;
+	while (spriteIndex != SPRITE_INDEX_NULL && count < MAX_SPRITES) {
+		_peepUpdateOrder[count++] = spriteIndex;
+		spriteIndex = g_sprite_list[spriteIndex].peep.next;
+	}
+
+	// The updates have to stay serial and in list order: they all draw from
+	// scenario_rand, guests join ride queues, buy items and drop litter, and
+	// some (e.g. the easter egg names) change nearby peeps. Any reordering
+	// would desync network games and change the outcome of saved parks.
+	for (i = 0; i < count; i++) {
+		if (i + PEEP_UPDATE_PREFETCH_DISTANCE < count)
+			PREFETCH(&g_sprite_list[_peepUpdateOrder[i + PEEP_UPDATE_PREFETCH_DISTANCE]]);
+
+		// Peeps only ever remove themselves during an update, but check the
+		// slot is still a peep in case it has been freed and reused since
+		peep = &(g_sprite_list[_peepUpdateOrder[i]].peep);
+		if (peep->linked_list_type_offset != SPRITE_LINKEDLIST_OFFSET_PEEP)
+			continue;
 
 		if ((i & 0x7F) != (gCurrentTicks & 0x7F)) {
 			peep_update(peep);
@@ -185,8 +255,6 @@ void peep_update_all()
 			if (peep->linked_list_type_offset == SPRITE_LINKEDLIST_OFFSET_PEEP)
 				peep_update(peep);
 		}
-
-		i++;
 	}
 }
 
@@ -205,8 +273,8 @@ static uint8 peep_assess_surroundings(sint16 center_x, sint16 center_y, sint16 c
 
 	sint16 initial_x = max(center_x - 160, 0);
 	sint16 initial_y = max(center_y - 160, 0);
-	sint16 final_x = min(center_x + 160, 8192);
-	sint16 final_y = min(center_y + 160, 8192);
+	sint16 final_x = min(center_x + 160, MAXIMUM_MAP_SIZE_BIG);
+	sint16 final_y = min(center_y + 160, MAXIMUM_MAP_SIZE_BIG);
 
 	for (sint16 x = initial_x; x < final_x; x += 32){
 		for (sint16 y = initial_y; y < final_y; y += 32){
@@ -1191,7 +1259,7 @@ void peep_update_sprite_type(rct_peep* peep)
 		int x = peep->x & 0xFFE0;
 		int y = peep->y & 0xFFE0;
 
-		if (x < 0x1FFF && y < 0x1FFF) {
+		if (x < MAXIMUM_MAP_SIZE_BIG - 1 && y < MAXIMUM_MAP_SIZE_BIG - 1) {
 			rct_map_element* map_element = map_get_first_element_at(x / 32, y / 32);
 			while (1) {
 				if ((peep->z / 8) < map_element->base_height) break;
@@ -7388,7 +7456,7 @@ static int peep_move_one_tile(uint8 direction, rct_peep* peep){
 	x += TileDirectionDelta[direction].x;
 	y += TileDirectionDelta[direction].y;
 
-	if (x >= 8192 || y >= 8192){
+	if (x >= MAXIMUM_MAP_SIZE_BIG || y >= MAXIMUM_MAP_SIZE_BIG){
 		// This could loop!
 		return guest_surface_path_finding(peep);
 	}
@@ -9109,7 +9177,7 @@ static void peep_reset_pathfind_goal(rct_peep *peep)
 static bool peep_has_valid_xy(rct_peep *peep)
 {
 	if (peep->x != (sint16)0x8000) {
-		if (peep->x < (256 * 32) && peep->y < (256 * 32)) {
+		if (peep->x < MAXIMUM_MAP_SIZE_BIG && peep->y < MAXIMUM_MAP_SIZE_BIG) {
 			return true;
 		}
 	}
@@ -9319,7 +9387,7 @@ static bool peep_find_ride_to_look_at(rct_peep *peep, uint8 edge, uint8 *rideToV
 
 	uint16 x = peep->next_x + TileDirectionDelta[edge].x;
 	uint16 y = peep->next_y + TileDirectionDelta[edge].y;
-	if (x > 255 * 32 || y > 255 * 32) {
+	if (x > (MAXIMUM_MAP_SIZE_BIG - 32) || y > (MAXIMUM_MAP_SIZE_BIG - 32)) {
 		return false;
 	}
 
@@ -9388,7 +9456,7 @@ static bool peep_find_ride_to_look_at(rct_peep *peep, uint8 edge, uint8 *rideToV
 
 	x += TileDirectionDelta[edge].x;
 	y += TileDirectionDelta[edge].y;
-	if (x > 255 * 32 || y > 255 * 32) {
+	if (x > (MAXIMUM_MAP_SIZE_BIG - 32) || y > (MAXIMUM_MAP_SIZE_BIG - 32)) {
 		return false;
 	}
 
@@ -9456,7 +9524,7 @@ static bool peep_find_ride_to_look_at(rct_peep *peep, uint8 edge, uint8 *rideToV
 
 	x += TileDirectionDelta[edge].x;
 	y += TileDirectionDelta[edge].y;
-	if (x > 255 * 32 || y > 255 * 32) {
+	if (x > (MAXIMUM_MAP_SIZE_BIG - 32) || y > (MAXIMUM_MAP_SIZE_BIG - 32)) {
 		return false;
 	}
 
@@ -9931,6 +9999,35 @@ static bool peep_should_go_to_shop(rct_peep *peep, int rideIndex, bool peepAtSho
 	return true;
 }
 
+/**
+ * Sorts the rides with an excitement rating by descending excitement, ties keep the lowest ride index
+ * first. Ratings only change outside the peep update so the order is built once per update pass.
+ */
+static void peep_update_ride_excitement_order()
+{
+	int i, j;
+	rct_ride *ride;
+
+	if (_rideExcitementOrderValid)
+		return;
+
+	_rideExcitementOrderCount = 0;
+	FOR_ALL_RIDES(i, ride) {
+		// Unrated rides and rides rated zero can never be the most exciting one
+		if (ride->excitement == (ride_rating)0xFFFF || ride->excitement == 0)
+			continue;
+
+		for (j = _rideExcitementOrderCount; j > 0; j--) {
+			if (get_ride(_rideExcitementOrder[j - 1])->excitement >= ride->excitement)
+				break;
+			_rideExcitementOrder[j] = _rideExcitementOrder[j - 1];
+		}
+		_rideExcitementOrder[j] = i;
+		_rideExcitementOrderCount++;
+	}
+	_rideExcitementOrderValid = true;
+}
+
 /**
  *
  *  rct2: 0x00695DD2
@@ -9971,7 +10068,7 @@ static void peep_pick_ride_to_go_on(rct_peep *peep)
 		int cy = floor2(peep->y, 32);
 		for (int x = cx - 320; x <= cx + 320; x += 32) {
 			for (int y = cy - 320; y <= cy + 320; y += 32) {
-				if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
+				if (x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_BIG && y < MAXIMUM_MAP_SIZE_BIG) {
 					rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
 					do {
 						if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
@@ -9994,32 +10091,36 @@ static void peep_pick_ride_to_go_on(rct_peep *peep)
 		}
 	}
 
-	// Filter the considered rides
-	uint8 *potentialRides = (uint8*)0x00F1ADBC;
-	uint8 *nextPotentialRide = potentialRides;
-	int numPotentialRides = 0;
+	// Unrated rides can never be picked, but the g-force check on them draws from
+	// scenario_rand so they still have to be evaluated, in ride index order.
+	// A thinking peep that isn't heading to a ride has no other side effects.
+	uint32 *consideredRides = RCT2_ADDRESS(0x00F1AD98, uint32);
 	for (int i = 0; i < MAX_RIDES; i++) {
-		if (!(RCT2_ADDRESS(0x00F1AD98, uint32)[i >> 5] & (1u << (i & 0x1F))))
+		if (!(consideredRides[i >> 5] & (1u << (i & 0x1F))))
 			continue;
 
-		rct_ride *ride = get_ride(i);
-		if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_QUEUE_FULL)) {
-			if (peep_should_go_on_ride(peep, i, 0, PEEP_RIDE_DECISION_THINKING)) {
-				*nextPotentialRide++ = i;
-				numPotentialRides++;
-			}
-		}
+		ride = get_ride(i);
+		if (ride->excitement != (ride_rating)0xFFFF) continue;
+		if (!(RideData4[ride->type].flags & RIDE_TYPE_FLAG4_PEEP_CHECK_GFORCES)) continue;
+		if (ride->lifecycle_flags & RIDE_LIFECYCLE_QUEUE_FULL) continue;
+
+		peep_should_go_on_ride(peep, i, 0, PEEP_RIDE_DECISION_THINKING);
 	}
 
-	// Pick the most exciting ride
+	// Pick the most exciting ride, the first one the peep accepts in excitement order
+	peep_update_ride_excitement_order();
 	int mostExcitingRideIndex = -1;
-	ride_rating mostExcitingRideRating = 0;
-	for (int i = 0; i < numPotentialRides; i++) {
-		ride = get_ride(potentialRides[i]);
-		if (ride->excitement == (ride_rating)0xFFFF) continue;
-		if (ride->excitement > mostExcitingRideRating) {
-			mostExcitingRideIndex = potentialRides[i];
-			mostExcitingRideRating = ride->excitement;
+	for (int j = 0; j < _rideExcitementOrderCount; j++) {
+		int i = _rideExcitementOrder[j];
+		if (!(consideredRides[i >> 5] & (1u << (i & 0x1F))))
+			continue;
+
+		ride = get_ride(i);
+		if (ride->lifecycle_flags & RIDE_LIFECYCLE_QUEUE_FULL) continue;
+
+		if (peep_should_go_on_ride(peep, i, 0, PEEP_RIDE_DECISION_THINKING)) {
+			mostExcitingRideIndex = i;
+			break;
 		}
 	}
 	if (mostExcitingRideIndex == -1)
@@ -10087,7 +10188,7 @@ static void peep_head_for_nearest_ride_type(rct_peep *peep, int rideType)
 		int cy = floor2(peep->y, 32);
 		for (int x = cx - 320; x <= cx + 320; x += 32) {
 			for (int y = cy - 320; y <= cy + 320; y += 32) {
-				if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
+				if (x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_BIG && y < MAXIMUM_MAP_SIZE_BIG) {
 					rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
 					do {
 						if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
@@ -10199,7 +10300,7 @@ static void peep_head_for_nearest_ride_with_flags(rct_peep *peep, int rideTypeFl
 		int cy = floor2(peep->y, 32);
 		for (int x = cx - 320; x <= cx + 320; x += 32) {
 			for (int y = cy - 320; y <= cy + 320; y += 32) {
-				if (x >= 0 && y >= 0 && x < (256 * 32) && y < (256 * 32)) {
+				if (x >= 0 && y >= 0 && x < MAXIMUM_MAP_SIZE_BIG && y < MAXIMUM_MAP_SIZE_BIG) {
 					rct_map_element *mapElement = map_get_first_element_at(x >> 5, y >> 5);
 					do {
 						if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_TRACK) continue;
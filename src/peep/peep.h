@@ -580,6 +580,20 @@ enum {
 	EASTEREGG_PEEP_NAME_DAVID_ELLIS
 };
 
+// A thought counts as current while its age (var_2) is at most this
+#define PEEP_THOUGHT_CURRENT_AGE 5
+
+/**
+ * Counts of the guests inside the park, built in a single pass over the guest list and shared by everything that
+ * asks for it within the same tick.
+ */
+typedef struct {
+	uint16 guests;
+	uint16 happy_guests;					// happiness above 128
+	uint16 lost_guests;						// leaving but unable to find the exit
+	uint16 current_thoughts[256];			// by type of the newest thought, if no older than PEEP_THOUGHT_CURRENT_AGE
+} rct_guest_histogram;
+
 /** Helper macro until rides are stored in this module. */
 #define GET_PEEP(sprite_index) &(g_sprite_list[sprite_index].peep)
 
@@ -612,6 +626,8 @@ enum {
 int peep_get_staff_count();
 int peep_can_be_picked_up(rct_peep* peep);
 void peep_update_all();
+const rct_guest_histogram *peep_get_guest_histogram();
+void peep_invalidate_guest_histogram();
 void peep_problem_warnings_update();
 void peep_update_crowd_noise();
 void peep_update_days_in_queue();
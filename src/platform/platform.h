@@ -164,6 +164,8 @@ int platform_get_drives();
 bool platform_file_copy(const utf8 *srcPath, const utf8 *dstPath, bool overwrite);
 bool platform_file_move(const utf8 *srcPath, const utf8 *dstPath);
 bool platform_file_delete(const utf8 *path);
+void *platform_file_map(const utf8 *path, size_t *outSize);
+void platform_file_unmap(void *data, size_t size);
 void platform_hide_cursor();
 void platform_show_cursor();
 void platform_get_cursor_position(int *x, int *y);
@@ -43,6 +43,8 @@
 #include <time.h>
 #include <fts.h>
 #include <sys/file.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 // The name of the mutex used to prevent multiple instances of the game from running
 #define SINGLE_INSTANCE_MUTEX_NAME "openrct2.lock"
@@ -623,6 +625,38 @@ bool platform_file_delete(const utf8 *path)
 	return ret == 0;
 }
 
+/**
+ * Maps a whole file into memory. Pages are private copy-on-write, so the
+ * caller may write to them without affecting the file. Returns NULL on failure.
+ */
+void *platform_file_map(const utf8 *path, size_t *outSize)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd == -1) {
+		return NULL;
+	}
+
+	struct stat buf;
+	if (fstat(fd, &buf) != 0 || buf.st_size <= 0) {
+		close(fd);
+		return NULL;
+	}
+
+	void *data = mmap(NULL, (size_t)buf.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		return NULL;
+	}
+
+	*outSize = (size_t)buf.st_size;
+	return data;
+}
+
+void platform_file_unmap(void *data, size_t size)
+{
+	munmap(data, size);
+}
+
 wchar_t *regular_to_wchar(const char* src)
 {
 	int len = strnlen(src, MAX_PATH);
@@ -74,6 +74,13 @@ static int _screenBufferWidth;
 static int _screenBufferHeight;
 static int _screenBufferPitch;
 
+// Copy of the last presented frame, used to only expand and upload the parts of the screen that changed
+static uint8 *_presentedBuffer;
+static bool _presentFull;
+static bool _presentPaletteChanged;
+
+#define MAX_PRESENT_RECTS 64
+
 static SDL_Cursor* _cursors[CURSOR_COUNT];
 static const int _fullscreen_modes[] = { 0, SDL_WINDOW_FULLSCREEN, SDL_WINDOW_FULLSCREEN_DESKTOP };
 static unsigned int _lastGestureTimestamp;
@@ -87,6 +94,8 @@ static void platform_load_cursors();
 static void platform_unload_cursors();
 
 static void platform_refresh_screenbuffer(int width, int height, int pitch);
+static int platform_get_changed_rects(SDL_Rect *rects, int maxRects);
+static void platform_expand_rect(const SDL_Rect *rect);
 
 int resolution_sort_func(const void *pa, const void *pb)
 {
@@ -221,43 +230,156 @@ static void overlay_post_render_check(int width, int height) {
 	overlayActive = newOverlayActive;
 }
 
+static bool platform_get_changed_span(const uint8 *src, const uint8 *presented, int width, int *left, int *right)
+{
+	if (memcmp(src, presented, width) == 0)
+		return false;
+
+	int l = 0;
+	while (src[l] == presented[l])
+		l++;
+	int r = width;
+	while (src[r - 1] == presented[r - 1])
+		r--;
+
+	*left = l;
+	*right = r;
+	return true;
+}
+
+/**
+ * Compares the screen buffer with the last presented frame and returns the changed regions as
+ * bands of consecutive changed rows, updating the presented copy as it goes. Everything that
+ * writes to the screen buffer (window redraws, viewport scrolling, rain, chat, the console) is
+ * caught this way, not just the blocks invalidated through the dirty grid.
+ */
+static int platform_get_changed_rects(SDL_Rect *rects, int maxRects)
+{
+	int width = _screenBufferWidth;
+	int height = _screenBufferHeight;
+	uint8 *src = (uint8*)_screenBuffer;
+	uint8 *presented = _presentedBuffer;
+
+	// Any pixel may use a palette entry that changed, so everything is expanded again. Palette animation does this
+	// most frames, so the presented copy is not kept in step here. It is brought up to date by the next full present
+	// without a palette change instead.
+	if (_presentPaletteChanged) {
+		rects[0].x = 0;
+		rects[0].y = 0;
+		rects[0].w = width;
+		rects[0].h = height;
+		_presentPaletteChanged = false;
+		_presentFull = true;
+		return 1;
+	}
+
+	if (_presentFull) {
+		for (int y = 0; y < height; y++) {
+			memcpy(presented + (y * width), src + (y * _screenBufferPitch), width);
+		}
+		rects[0].x = 0;
+		rects[0].y = 0;
+		rects[0].w = width;
+		rects[0].h = height;
+		_presentFull = false;
+		return 1;
+	}
+
+	int numRects = 0;
+	SDL_Rect *band = NULL;
+	for (int y = 0; y < height; y++) {
+		uint8 *srcRow = src + (y * _screenBufferPitch);
+		uint8 *presentedRow = presented + (y * width);
+		int left, right;
+		if (!platform_get_changed_span(srcRow, presentedRow, width, &left, &right)) {
+			band = NULL;
+			continue;
+		}
+		memcpy(presentedRow + left, srcRow + left, right - left);
+
+		if (band == NULL && numRects < maxRects) {
+			band = &rects[numRects++];
+			band->x = left;
+			band->y = y;
+			band->w = right - left;
+			band->h = 1;
+		} else {
+			// Extend the current band, or the last one if we have run out of rects
+			if (band == NULL)
+				band = &rects[numRects - 1];
+			int bandRight = max(band->x + band->w, right);
+			band->x = min(band->x, left);
+			band->w = bandRight - band->x;
+			band->h = y - band->y + 1;
+		}
+	}
+	return numRects;
+}
+
+static void platform_expand_row_32(uint32 *dst, const uint8 *src, int width)
+{
+	const uint32 *palette = gPaletteHWMapped;
+	int x = 0;
+	for (; x + 4 <= width; x += 4) {
+		dst[x + 0] = palette[src[x + 0]];
+		dst[x + 1] = palette[src[x + 1]];
+		dst[x + 2] = palette[src[x + 2]];
+		dst[x + 3] = palette[src[x + 3]];
+	}
+	for (; x < width; x++) {
+		dst[x] = palette[src[x]];
+	}
+}
+
+/**
+ * Expands a region of the 8-bit screen buffer through the mapped palette into the streaming texture.
+ */
+static void platform_expand_rect(const SDL_Rect *rect)
+{
+	void *pixels;
+	int pitch;
+	if (SDL_LockTexture(gBufferTexture, rect, &pixels, &pitch) != 0) {
+		_presentFull = true;
+		return;
+	}
+
+	const uint8 *src = (uint8*)_screenBuffer + (rect->y * _screenBufferPitch) + rect->x;
+	uint8 *dst = (uint8*)pixels;
+	int bytesPerPixel = gBufferTextureFormat->BytesPerPixel;
+	for (int y = 0; y < rect->h; y++) {
+		switch (bytesPerPixel) {
+		case 4:
+			platform_expand_row_32((uint32*)dst, src, rect->w);
+			break;
+		case 2:
+			for (int x = 0; x < rect->w; x++) {
+				((uint16*)dst)[x] = (uint16)gPaletteHWMapped[src[x]];
+			}
+			break;
+		case 1:
+			for (int x = 0; x < rect->w; x++) {
+				dst[x] = (uint8)gPaletteHWMapped[src[x]];
+			}
+			break;
+		}
+		src += _screenBufferPitch;
+		dst += pitch;
+	}
+	SDL_UnlockTexture(gBufferTexture);
+}
+
 void platform_draw()
 {
 	int width = gScreenWidth;
 	int height = gScreenHeight;
 
 	if (!gOpenRCT2Headless) {
+		SDL_Rect rects[MAX_PRESENT_RECTS];
+		int numRects = platform_get_changed_rects(rects, MAX_PRESENT_RECTS);
+
 		if (gHardwareDisplay) {
-			void *pixels;
-			int pitch;
-			if (SDL_LockTexture(gBufferTexture, NULL, &pixels, &pitch) == 0) {
-				uint8 *src = (uint8*)_screenBuffer;
-				int padding = pitch - (width * 4);
-				if (pitch == width * 4) {
-					uint32 *dst = pixels;
-					for (int i = width * height; i > 0; i--) { *dst++ = *(uint32 *)(&gPaletteHWMapped[*src++]); }
-				}
-				else
-					if (pitch == (width * 2) + padding) {
-						uint16 *dst = pixels;
-						for (int y = height; y > 0; y--) {
-							for (int x = width; x > 0; x--) {
-								const uint8 lower = *(uint8 *)(&gPaletteHWMapped[*src++]);
-								const uint8 upper = *(uint8 *)(&gPaletteHWMapped[*src++]);
-								*dst++ = (lower << 8) | upper;
-							}
-							dst = (uint16*)(((uint8 *)dst) + padding);
-						}
-					}
-					else
-						if (pitch == width + padding) {
-							uint8 *dst = pixels;
-							for (int y = height; y > 0; y--) {
-								for (int x = width; x > 0; x--) { *dst++ = *(uint8 *)(&gPaletteHWMapped[*src++]); }
-								dst += padding;
-							}
-						}
-				SDL_UnlockTexture(gBufferTexture);
+			for (int i = 0; i < numRects; i++) {
+				platform_expand_rect(&rects[i]);
 			}
 
 			SDL_RenderCopy(gRenderer, gBufferTexture, NULL, NULL);
@@ -273,16 +395,26 @@ void platform_draw()
 			}
 		}
 		else {
+			// Nothing has changed since the last present
+			if (numRects == 0)
+				return;
+
 			// Lock the surface before setting its pixels
 			if (SDL_MUSTLOCK(_surface)) {
 				if (SDL_LockSurface(_surface) < 0) {
 					log_error("locking failed %s", SDL_GetError());
+					_presentFull = true;
 					return;
 				}
 			}
 
-			// Copy pixels from the virtual screen buffer to the surface
-			memcpy(_surface->pixels, _screenBuffer, _surface->pitch * _surface->h);
+			// Copy the changed pixels from the virtual screen buffer to the surface
+			for (int i = 0; i < numRects; i++) {
+				for (int y = rects[i].y; y < rects[i].y + rects[i].h; y++) {
+					int offset = (y * _surface->pitch) + rects[i].x;
+					memcpy((uint8*)_surface->pixels + offset, (uint8*)_screenBuffer + offset, rects[i].w);
+				}
+			}
 
 			// Unlock the surface
 			if (SDL_MUSTLOCK(_surface))
@@ -291,8 +423,16 @@ void platform_draw()
 			// Copy the surface to the window
 			if (gConfigGeneral.window_scale == 1 || gConfigGeneral.window_scale <= 0)
 			{
-				if (SDL_BlitSurface(_surface, NULL, SDL_GetWindowSurface(gWindow), NULL)) {
-					log_fatal("SDL_BlitSurface %s", SDL_GetError());
+				SDL_Surface *windowSurface = SDL_GetWindowSurface(gWindow);
+				for (int i = 0; i < numRects; i++) {
+					SDL_Rect dstRect = rects[i];
+					if (SDL_BlitSurface(_surface, &rects[i], windowSurface, &dstRect)) {
+						log_fatal("SDL_BlitSurface %s", SDL_GetError());
+						exit(1);
+					}
+				}
+				if (SDL_UpdateWindowSurfaceRects(gWindow, rects, numRects)) {
+					log_fatal("SDL_UpdateWindowSurfaceRects %s", SDL_GetError());
 					exit(1);
 				}
 			} else {
@@ -307,10 +447,10 @@ void platform_draw()
 					log_fatal("SDL_BlitScaled %s", SDL_GetError());
 					exit(1);
 				}
-			}
-			if (SDL_UpdateWindowSurface(gWindow)) {
-				log_fatal("SDL_UpdateWindowSurface %s", SDL_GetError());
-				exit(1);
+				if (SDL_UpdateWindowSurface(gWindow)) {
+					log_fatal("SDL_UpdateWindowSurface %s", SDL_GetError());
+					exit(1);
+				}
 			}
 		}
 	}
@@ -401,6 +541,9 @@ void platform_update_palette(const uint8* colours, int start_index, int num_colo
 	colours += start_index * 4;
 
 	for (i = start_index; i < num_colours + start_index; i++) {
+		SDL_Color oldColour = gPalette[i];
+		uint32 oldColourHWMapped = gPaletteHWMapped[i];
+
 		gPalette[i].r = colours[2];
 		gPalette[i].g = colours[1];
 		gPalette[i].b = colours[0];
@@ -417,6 +560,15 @@ void platform_update_palette(const uint8* colours, int start_index, int num_colo
 		if (gBufferTextureFormat != NULL) {
 			gPaletteHWMapped[i] = SDL_MapRGB(gBufferTextureFormat, gPalette[i].r, gPalette[i].g, gPalette[i].b);
 		}
+
+		if (
+			gPalette[i].r != oldColour.r ||
+			gPalette[i].g != oldColour.g ||
+			gPalette[i].b != oldColour.b ||
+			gPaletteHWMapped[i] != oldColourHWMapped
+		) {
+			_presentPaletteChanged = true;
+		}
 	}
 
 	if (!gOpenRCT2Headless && !gHardwareDisplay) {
@@ -468,6 +620,8 @@ void platform_process_messages()
 
 			if (e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
 				platform_resize(e.window.data1, e.window.data2);
+			if (e.window.event == SDL_WINDOWEVENT_EXPOSED)
+				_presentFull = true;
 			if (gConfigSound.audio_focus && gConfigSound.sound_enabled) {
 				if (e.window.event == SDL_WINDOWEVENT_FOCUS_GAINED) {
 					Mixer_SetVolume(1);
@@ -719,6 +873,8 @@ static void platform_close_window()
 		SDL_FreePalette(_palette);
 	if (_RGBASurface != NULL)
 		SDL_FreeSurface(_RGBASurface);
+	SafeFree(_presentedBuffer);
+	_presentFull = true;
 	platform_unload_cursors();
 }
 
@@ -1019,6 +1175,9 @@ static void platform_refresh_screenbuffer(int width, int height, int pitch)
 	_screenBufferHeight = height;
 	_screenBufferPitch = pitch;
 
+	_presentedBuffer = realloc(_presentedBuffer, width * height);
+	_presentFull = true;
+
 	rct_drawpixelinfo *screenDPI = &gScreenDPI;
 	screenDPI->bits = _screenBuffer;
 	screenDPI->x = 0;
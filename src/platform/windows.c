@@ -494,6 +494,46 @@ bool platform_file_delete(const utf8 *path)
 	return success == TRUE;
 }
 
+/**
+ * Maps a whole file into memory. Pages are private copy-on-write, so the
+ * caller may write to them without affecting the file. Returns NULL on failure.
+ */
+void *platform_file_map(const utf8 *path, size_t *outSize)
+{
+	wchar_t *wPath = utf8_to_widechar(path);
+	HANDLE file = CreateFileW(wPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	free(wPath);
+	if (file == INVALID_HANDLE_VALUE) {
+		return NULL;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+		CloseHandle(file);
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	CloseHandle(file);
+	if (mapping == NULL) {
+		return NULL;
+	}
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == NULL) {
+		return NULL;
+	}
+
+	*outSize = (size_t)fileSize.QuadPart;
+	return data;
+}
+
+void platform_file_unmap(void *data, size_t size)
+{
+	UnmapViewOfFile(data);
+}
+
 void platform_resolve_openrct_data_path()
 {
 	wchar_t wOutPath[MAX_PATH];
@@ -99,6 +99,7 @@ void S4Importer::Initialise()
     reset_park_entrances();
     user_string_clear_all();
     reset_sprite_list();
+    peep_invalidate_guest_histogram();
     ride_init_all();
     window_guest_list_init_vars_a();
     staff_reset_modes();
@@ -739,14 +740,10 @@ void S4Importer::ImportMapElements()
 {
     memcpy(gMapElements, _s4.map_elements, 0xC000 * sizeof(rct_map_element));
     ClearExtraTileEntries();
-    FixColours();
-    FixZ();
-    FixPaths();
+    FixMapElements();
     FixWalls();
     FixBanners();
-    FixTerrain();
-    FixEntrancePositions();
-    FixMapElementEntryTypes();
+    FixTiles();
 }
 
 void S4Importer::ImportResearch()
@@ -1098,10 +1095,12 @@ void S4Importer::ClearExtraTileEntries()
     gNextFreeMapElement = nextFreeMapElement;
 }
 
-void S4Importer::FixColours()
+/**
+ * Converts every map element in a single sweep, each element is decoded once and all of the
+ * per-element fix-ups are applied to it in turn.
+ */
+void S4Importer::FixMapElements()
 {
-    colour_t colour;
-
     // The following code would be worth doing if we were able to import sprites
     // for (int i = 0; i < MAX_SPRITES; i++)
     // {
@@ -1127,55 +1126,6 @@ void S4Importer::FixColours()
     //     }
     // }
 
-    rct_map_element * mapElement = gMapElements;
-    while (mapElement < gNextFreeMapElement)
-    {
-        if (mapElement->base_height != 255)
-        {
-            switch (map_element_get_type(mapElement)) {
-            case MAP_ELEMENT_TYPE_SCENERY:
-                colour = RCT1::GetColour(mapElement->properties.scenery.colour_1 & 0x1F);
-                mapElement->properties.scenery.colour_1 &= 0xE0;
-                mapElement->properties.scenery.colour_1 |= colour;
-
-                // Copied from [rct2: 0x006A2956]
-                switch (mapElement->properties.scenery.type) {
-                case 157:	// TGE1	(Geometric Sculpture)
-                case 162:	// TGE2	(Geometric Sculpture)
-                case 168:	// TGE3	(Geometric Sculpture)
-                case 170:	// TGE4	(Geometric Sculpture)
-                case 171:	// TGE5	(Geometric Sculpture)
-                    mapElement->properties.scenery.colour_2 = COLOUR_WHITE;
-                    break;
-                }
-                break;
-            case MAP_ELEMENT_TYPE_FENCE:
-                colour = ((mapElement->type & 0xC0) >> 3) |
-                         ((mapElement->properties.fence.type & 0xE0) >> 5);
-                colour = RCT1::GetColour(colour);
-
-                mapElement->type &= 0x3F;
-                mapElement->properties.fence.type &= 0x1F;
-                mapElement->type |= (colour & 0x18) << 3;
-                mapElement->properties.fence.type |= (colour & 7) << 5;
-                break;
-            case MAP_ELEMENT_TYPE_SCENERY_MULTIPLE:
-                colour = RCT1::GetColour(mapElement->properties.scenerymultiple.colour[0] & 0x1F);
-                mapElement->properties.scenerymultiple.colour[0] &= 0xE0;
-                mapElement->properties.scenerymultiple.colour[0] |= colour;
-
-                colour = RCT1::GetColour(mapElement->properties.scenerymultiple.colour[1] & 0x1F);
-                mapElement->properties.scenerymultiple.colour[1] &= 0xE0;
-                mapElement->properties.scenerymultiple.colour[1] |= colour;
-                break;
-            }
-        }
-        mapElement++;
-    }
-}
-
-void S4Importer::FixZ()
-{
     // The following code would be useful if we imported sprites
     // for (int i = 0; i < MAX_SPRITES; i++)
     // {
@@ -1190,71 +1140,119 @@ void S4Importer::FixZ()
     rct_map_element * mapElement = gMapElements;
     while (mapElement < gNextFreeMapElement)
     {
-        if (mapElement->base_height != 255)
-        {
-            mapElement->base_height /= 2;
-            mapElement->clearance_height /= 2;
-        }
+        FixColours(mapElement);
+        FixZ(mapElement);
+        FixPaths(mapElement);
         mapElement++;
     }
     RCT2_GLOBAL(0x01359208, uint16) = 7;
 }
 
-void S4Importer::FixPaths()
+void S4Importer::FixColours(rct_map_element * mapElement)
 {
-    rct_map_element * mapElement = gMapElements;
-    while (mapElement < gNextFreeMapElement)
+    colour_t colour;
+
+    if (mapElement->base_height != 255)
     {
         switch (map_element_get_type(mapElement)) {
-        case MAP_ELEMENT_TYPE_PATH:
-        {
-            // Type
-            uint8 pathColour = mapElement->type & 3;
-            uint8 pathType = (mapElement->properties.path.type & 0xF0) >> 4;
-            uint8 supportsType = (mapElement->flags & 0x60) >> 5;
+        case MAP_ELEMENT_TYPE_SCENERY:
+            colour = RCT1::GetColour(mapElement->properties.scenery.colour_1 & 0x1F);
+            mapElement->properties.scenery.colour_1 &= 0xE0;
+            mapElement->properties.scenery.colour_1 |= colour;
+
+            // Copied from [rct2: 0x006A2956]
+            switch (mapElement->properties.scenery.type) {
+            case 157:	// TGE1	(Geometric Sculpture)
+            case 162:	// TGE2	(Geometric Sculpture)
+            case 168:	// TGE3	(Geometric Sculpture)
+            case 170:	// TGE4	(Geometric Sculpture)
+            case 171:	// TGE5	(Geometric Sculpture)
+                mapElement->properties.scenery.colour_2 = COLOUR_WHITE;
+                break;
+            }
+            break;
+        case MAP_ELEMENT_TYPE_FENCE:
+            colour = ((mapElement->type & 0xC0) >> 3) |
+                     ((mapElement->properties.fence.type & 0xE0) >> 5);
+            colour = RCT1::GetColour(colour);
+
+            mapElement->type &= 0x3F;
+            mapElement->properties.fence.type &= 0x1F;
+            mapElement->type |= (colour & 0x18) << 3;
+            mapElement->properties.fence.type |= (colour & 7) << 5;
+            break;
+        case MAP_ELEMENT_TYPE_SCENERY_MULTIPLE:
+            colour = RCT1::GetColour(mapElement->properties.scenerymultiple.colour[0] & 0x1F);
+            mapElement->properties.scenerymultiple.colour[0] &= 0xE0;
+            mapElement->properties.scenerymultiple.colour[0] |= colour;
 
-            pathType = (pathType << 2) | pathColour;
-            uint8 entryIndex = _pathTypeToEntryMap[pathType];
+            colour = RCT1::GetColour(mapElement->properties.scenerymultiple.colour[1] & 0x1F);
+            mapElement->properties.scenerymultiple.colour[1] &= 0xE0;
+            mapElement->properties.scenerymultiple.colour[1] |= colour;
+            break;
+        }
+    }
+}
 
-            mapElement->type &= 0xFC;
-            mapElement->flags &= ~0x60;
-            mapElement->flags &= ~MAP_ELEMENT_FLAG_BROKEN;
-            mapElement->properties.path.type &= 0x0F;
-            footpath_scenery_set_is_ghost(mapElement, false);
-            if (RCT1::PathIsQueue(pathType))
-            {
-                mapElement->type |= 1;
-            }
-            mapElement->properties.path.type |= entryIndex << 4;
+void S4Importer::FixZ(rct_map_element * mapElement)
+{
+    if (mapElement->base_height != 255)
+    {
+        mapElement->base_height /= 2;
+        mapElement->clearance_height /= 2;
+    }
+}
+
+void S4Importer::FixPaths(rct_map_element * mapElement)
+{
+    switch (map_element_get_type(mapElement)) {
+    case MAP_ELEMENT_TYPE_PATH:
+    {
+        // Type
+        uint8 pathColour = mapElement->type & 3;
+        uint8 pathType = (mapElement->properties.path.type & 0xF0) >> 4;
+        uint8 supportsType = (mapElement->flags & 0x60) >> 5;
+
+        pathType = (pathType << 2) | pathColour;
+        uint8 entryIndex = _pathTypeToEntryMap[pathType];
+
+        mapElement->type &= 0xFC;
+        mapElement->flags &= ~0x60;
+        mapElement->flags &= ~MAP_ELEMENT_FLAG_BROKEN;
+        mapElement->properties.path.type &= 0x0F;
+        footpath_scenery_set_is_ghost(mapElement, false);
+        if (RCT1::PathIsQueue(pathType))
+        {
+            mapElement->type |= 1;
+        }
+        mapElement->properties.path.type |= entryIndex << 4;
 
-            // Additions
-            uint8 additionType = footpath_element_get_path_scenery(mapElement);
-            if (additionType != RCT1_PATH_ADDITION_NONE)
+        // Additions
+        uint8 additionType = footpath_element_get_path_scenery(mapElement);
+        if (additionType != RCT1_PATH_ADDITION_NONE)
+        {
+            uint8 normalisedType = RCT1::NormalisePathAddition(additionType);
+            uint8 entryIndex = _pathAdditionTypeToEntryMap[normalisedType];
+            if (additionType != normalisedType)
             {
-                uint8 normalisedType = RCT1::NormalisePathAddition(additionType);
-                uint8 entryIndex = _pathAdditionTypeToEntryMap[normalisedType];
-                if (additionType != normalisedType)
-                {
-                    mapElement->flags |= MAP_ELEMENT_FLAG_BROKEN;
-                }
-                footpath_element_set_path_scenery(mapElement, entryIndex + 1);
+                mapElement->flags |= MAP_ELEMENT_FLAG_BROKEN;
             }
-            break;
+            footpath_element_set_path_scenery(mapElement, entryIndex + 1);
         }
-        case MAP_ELEMENT_TYPE_ENTRANCE:
-            if (mapElement->properties.entrance.type == ENTRANCE_TYPE_PARK_ENTRANCE)
+        break;
+    }
+    case MAP_ELEMENT_TYPE_ENTRANCE:
+        if (mapElement->properties.entrance.type == ENTRANCE_TYPE_PARK_ENTRANCE)
+        {
+            uint8 pathType = mapElement->properties.entrance.path_type;
+            if (pathType == 0)
             {
-                uint8 pathType = mapElement->properties.entrance.path_type;
-                if (pathType == 0)
-                {
-                    pathType = RCT1_FOOTPATH_TYPE_TARMAC_GRAY;
-                }
-                uint8 entryIndex = _pathTypeToEntryMap[pathType];
-                mapElement->properties.entrance.path_type = entryIndex & 0x7F;
+                pathType = RCT1_FOOTPATH_TYPE_TARMAC_GRAY;
             }
-            break;
+            uint8 entryIndex = _pathTypeToEntryMap[pathType];
+            mapElement->properties.entrance.path_type = entryIndex & 0x7F;
         }
-        mapElement++;
+        break;
     }
 }
 
@@ -1379,22 +1377,11 @@ void S4Importer::ImportBanner(rct_banner * dst, rct_banner * src)
     }
 }
 
-void S4Importer::FixTerrain()
-{
-    map_element_iterator it;
-    map_element_iterator_begin(&it);
-    while (map_element_iterator_next(&it))
-    {
-        rct_map_element * element = it.element;
-        if (map_element_get_type(element) == MAP_ELEMENT_TYPE_SURFACE)
-        {
-            map_element_set_terrain(element, RCT1::GetTerrain(map_element_get_terrain(element)));
-            map_element_set_terrain_edge(element, RCT1::GetTerrainEdge(map_element_get_terrain_edge(element)));
-        }
-    }
-}
-
-void S4Importer::FixEntrancePositions()
+/**
+ * Converts the terrain and scenery entry types and finds the park entrances in a single walk over
+ * the tiles. Runs after the walls have been placed as that moves elements around.
+ */
+void S4Importer::FixTiles()
 {
     for (int i = 0; i < 4; i++)
     {
@@ -1405,41 +1392,48 @@ void S4Importer::FixEntrancePositions()
 
     map_element_iterator it;
     map_element_iterator_begin(&it);
-    while (map_element_iterator_next(&it) && entranceIndex < 4)
+    while (map_element_iterator_next(&it))
     {
-        rct_map_element * element = it.element;
+        rct_map_element * mapElement = it.element;
+        FixTerrain(mapElement);
+        FixMapElementEntryType(mapElement);
 
-        if (map_element_get_type(element) != MAP_ELEMENT_TYPE_ENTRANCE) continue;
-        if (element->properties.entrance.type != ENTRANCE_TYPE_PARK_ENTRANCE) continue;
-        if ((element->properties.entrance.index & 0x0F) != 0) continue;
+        if (entranceIndex < 4 &&
+            map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_ENTRANCE &&
+            mapElement->properties.entrance.type == ENTRANCE_TYPE_PARK_ENTRANCE &&
+            (mapElement->properties.entrance.index & 0x0F) == 0)
+        {
+            gParkEntranceX[entranceIndex] = it.x * 32;
+            gParkEntranceY[entranceIndex] = it.y * 32;
+            gParkEntranceZ[entranceIndex] = mapElement->base_height * 8;
+            gParkEntranceDirection[entranceIndex] = mapElement->type & 3;
+            entranceIndex++;
+        }
+    }
+}
 
-        gParkEntranceX[entranceIndex] = it.x * 32;
-        gParkEntranceY[entranceIndex] = it.y * 32;
-        gParkEntranceZ[entranceIndex] = element->base_height * 8;
-        gParkEntranceDirection[entranceIndex] = element->type & 3;
-        entranceIndex++;
+void S4Importer::FixTerrain(rct_map_element * mapElement)
+{
+    if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_SURFACE)
+    {
+        map_element_set_terrain(mapElement, RCT1::GetTerrain(map_element_get_terrain(mapElement)));
+        map_element_set_terrain_edge(mapElement, RCT1::GetTerrainEdge(map_element_get_terrain_edge(mapElement)));
     }
 }
 
-void S4Importer::FixMapElementEntryTypes()
+void S4Importer::FixMapElementEntryType(rct_map_element * mapElement)
 {
-    map_element_iterator it;
-    map_element_iterator_begin(&it);
-    while (map_element_iterator_next(&it))
+    switch (map_element_get_type(mapElement)) {
+    case MAP_ELEMENT_TYPE_SCENERY:
+        mapElement->properties.scenery.type = _smallSceneryTypeToEntryMap[mapElement->properties.scenery.type];
+        break;
+    case MAP_ELEMENT_TYPE_SCENERY_MULTIPLE:
     {
-        rct_map_element * mapElement = it.element;
-        switch (map_element_get_type(mapElement)) {
-        case MAP_ELEMENT_TYPE_SCENERY:
-            mapElement->properties.scenery.type = _smallSceneryTypeToEntryMap[mapElement->properties.scenery.type];
-            break;
-        case MAP_ELEMENT_TYPE_SCENERY_MULTIPLE:
-        {
-            uint8 type = mapElement->properties.scenerymultiple.type & MAP_ELEMENT_LARGE_TYPE_MASK;
-            mapElement->properties.scenerymultiple.type &= ~MAP_ELEMENT_LARGE_TYPE_MASK;
-            mapElement->properties.scenerymultiple.type |= _largeSceneryTypeToEntryMap[type];
-            break;
-        }
-        }
+        uint8 type = mapElement->properties.scenerymultiple.type & MAP_ELEMENT_LARGE_TYPE_MASK;
+        mapElement->properties.scenerymultiple.type &= ~MAP_ELEMENT_LARGE_TYPE_MASK;
+        mapElement->properties.scenerymultiple.type |= _largeSceneryTypeToEntryMap[type];
+        break;
+    }
     }
 }
 
@@ -89,16 +89,17 @@ private:
     void ImportSavedView();
 
     void ClearExtraTileEntries();
-    void FixColours();
-    void FixZ();
-    void FixPaths();
+    void FixMapElements();
+    void FixColours(rct_map_element * mapElement);
+    void FixZ(rct_map_element * mapElement);
+    void FixPaths(rct_map_element * mapElement);
     void FixWalls();
     void ConvertWall(int * type, int * colourA, int * colourB, int * colourC);
     void FixBanners();
     void ImportBanner(rct_banner * dst, rct_banner * src);
-    void FixTerrain();
-    void FixEntrancePositions();
-    void FixMapElementEntryTypes();
+    void FixTiles();
+    void FixTerrain(rct_map_element * mapElement);
+    void FixMapElementEntryType(rct_map_element * mapElement);
 
     List<const char *> * GetEntryList(uint8 objectType);
     const rct1_research_item * GetResearchList(size_t * count);
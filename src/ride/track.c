@@ -258,6 +258,17 @@ uint32* sub_6AB49A(rct_object_entry* entry){
 	return (((uint32*)object_get_next(object_list_entry)) - 1);
 }
 
+#define TRACK_LIST_CACHE_VERSION 0x58444954 // TIDX
+
+// Size and modification date of a track design file, stored after the vehicle object of each tracks.idx entry
+typedef struct {
+	uint64 size;
+	uint64 last_modified;
+} rct_track_list_file_record;
+
+// Maximum size of a single tracks.idx entry
+#define TRACK_LIST_CACHE_MAX_ENTRY_SIZE (1 + sizeof(rct_object_entry) + sizeof(rct_track_list_file_record) + MAX_PATH)
+
 static void get_track_idx_path(char *outPath)
 {
 	platform_get_user_directory(outPath, NULL);
@@ -285,6 +296,7 @@ static int track_list_cache_save(int fileCount, uint8* track_list_cache, uint32
 {
 	char path[MAX_PATH];
 	SDL_RWops *file;
+	uint32 version = TRACK_LIST_CACHE_VERSION;
 
 	log_verbose("saving track list cache (tracks.idx)");
 	get_track_idx_path(path);
@@ -295,6 +307,7 @@ static int track_list_cache_save(int fileCount, uint8* track_list_cache, uint32
 		return 0;
 	}
 
+	SDL_RWwrite(file, &version, sizeof(version), 1);
 	SDL_RWwrite(file, &fileCount, sizeof(int), 1);
 	SDL_RWwrite(file, track_list_cache, track_list_size, 1);
 	uint8 last_entry = 0xFE;
@@ -303,7 +316,10 @@ static int track_list_cache_save(int fileCount, uint8* track_list_cache, uint32
 	return 1;
 }
 
-static uint8* track_list_cache_load(int totalFiles)
+/**
+ * Loads the track list cache. If outFileCount is NULL the cache is only returned if it was saved for totalFiles.
+ */
+static uint8* track_list_cache_load(int totalFiles, int *outFileCount)
 {
 	char path[MAX_PATH];
 	SDL_RWops *file;
@@ -317,23 +333,41 @@ static uint8* track_list_cache_load(int totalFiles)
 	}
 
 	uint8* track_list_cache;
-	uint32 fileCount;
-	// Remove 4 for the file count variable
-	long track_list_size = (long)SDL_RWsize(file) - 4;
+	uint32 version, fileCount;
+	// Remove 8 for the version and file count variables
+	long track_list_size = (long)SDL_RWsize(file) - 8;
 
-	if (track_list_size < 0) return 0;
+	if (track_list_size <= 0) {
+		SDL_RWclose(file);
+		return 0;
+	}
 
+	SDL_RWread(file, &version, 4, 1);
 	SDL_RWread(file, &fileCount, 4, 1);
 
-	if (fileCount != totalFiles){
+	if (version != TRACK_LIST_CACHE_VERSION) {
+		SDL_RWclose(file);
+		log_verbose("Track list cache is out of date.");
+		return 0;
+	}
+
+	if (outFileCount == NULL && fileCount != totalFiles){
 		SDL_RWclose(file);
 		log_verbose("Track file count is different.");
 		return 0;
 	}
 
 	track_list_cache = malloc(track_list_size);
-	SDL_RWread(file, track_list_cache, track_list_size, 1);
+	if (SDL_RWread(file, track_list_cache, track_list_size, 1) != 1 || track_list_cache[track_list_size - 1] != 0xFE) {
+		SDL_RWclose(file);
+		free(track_list_cache);
+		log_error("Track list cache is corrupt.");
+		return 0;
+	}
 	SDL_RWclose(file);
+
+	if (outFileCount != NULL)
+		*outFileCount = fileCount;
 	return track_list_cache;
 }
 
@@ -345,7 +379,7 @@ void track_list_populate(ride_list_item item, uint8* track_list_cache){
 		track_pointer += strlen((const char *)track_pointer) + 1,
 		track_type = *track_pointer++){
 		rct_object_entry* track_object = (rct_object_entry*)track_pointer;
-		track_pointer += sizeof(rct_object_entry);
+		track_pointer += sizeof(rct_object_entry) + sizeof(rct_track_list_file_record);
 
 		if (track_type != item.type){
 			continue;
@@ -400,6 +434,121 @@ void track_list_populate(ride_list_item item, uint8* track_list_cache){
 	RCT2_ADDRESS(RCT2_ADDRESS_TRACK_LIST, uint8)[cur_track_entry_index * 128] = '\0';
 }
 
+/**
+ * Reads the ride type and vehicle object of a track design without loading the whole design. TD4 designs have to
+ * be converted before these are known so they still go through load_track_design.
+ */
+static bool track_design_read_header(const char *path, uint8 *outType, rct_object_entry *outVehicleObject)
+{
+	SDL_RWops *fp;
+	int fpLength;
+	uint8 *fpBuffer;
+	rct_track_td6 header;
+
+	fp = SDL_RWFromFile(path, "rb");
+	if (fp == NULL)
+		return false;
+
+	fpLength = (int)SDL_RWsize(fp);
+	if (fpLength <= 4) {
+		SDL_RWclose(fp);
+		return false;
+	}
+
+	fpBuffer = malloc(fpLength);
+	SDL_RWread(fp, fpBuffer, fpLength, 1);
+	SDL_RWclose(fp);
+
+	if (!sawyercoding_validate_track_checksum(fpBuffer, fpLength)) {
+		log_error("Track checksum failed.");
+		free(fpBuffer);
+		return false;
+	}
+
+	// The start of a decoded TD6 has the same layout as rct_track_td6
+	size_t headerLength = sawyercoding_decode_td6_partial(fpBuffer, (uint8*)&header, fpLength, sizeof(rct_track_td6));
+	free(fpBuffer);
+
+	if (headerLength < offsetof(rct_track_td6, version_and_colour_scheme) + 1)
+		return false;
+
+	uint8 version = header.version_and_colour_scheme >> 2;
+	if (version < 2) {
+		rct_track_td6 *trackDesign = load_track_design(path);
+		if (trackDesign == NULL)
+			return false;
+
+		*outType = trackDesign->type;
+		memcpy(outVehicleObject, &trackDesign->vehicle_object, sizeof(rct_object_entry));
+		return true;
+	}
+
+	if (version > 2 || headerLength < offsetof(rct_track_td6, vehicle_object) + sizeof(rct_object_entry))
+		return false;
+
+	*outType = header.type;
+	memcpy(outVehicleObject, &header.vehicle_object, sizeof(rct_object_entry));
+	return true;
+}
+
+static uint32 track_list_get_path_hash_code(const char *path)
+{
+	uint32 hash = 5381;
+	while (*path != '\0')
+		hash = ((hash << 5) + hash) + (uint8)*path++;
+
+	return hash;
+}
+
+/**
+ * Builds a hash table of the entries in a previous track list cache, indexed by file name.
+ */
+static uint8 **track_list_create_path_hash_table(uint8 *track_list_cache, int fileCount, uint32 *outSize)
+{
+	uint32 size = max(1024, fileCount * 4);
+	uint8 **hashTable = calloc(size, sizeof(uint8*));
+
+	uint8 *track_pointer = track_list_cache;
+	while (*track_pointer != 0xFE) {
+		uint8 *entry = track_pointer;
+		track_pointer += 1 + sizeof(rct_object_entry) + sizeof(rct_track_list_file_record);
+
+		uint32 index = track_list_get_path_hash_code((const char *)track_pointer) % size;
+		while (hashTable[index] != NULL) {
+			index++;
+			if (index >= size) index = 0;
+		}
+		hashTable[index] = entry;
+
+		track_pointer += strlen((const char *)track_pointer) + 1;
+	}
+
+	*outSize = size;
+	return hashTable;
+}
+
+/**
+ * Finds the entry of a file in a previous track list cache if the file has not been modified since.
+ */
+static uint8 *track_list_find_unchanged_entry(uint8 **hashTable, uint32 hashTableSize, const file_info *fileInfo)
+{
+	uint32 index = track_list_get_path_hash_code(fileInfo->path) % hashTableSize;
+	while (hashTable[index] != NULL) {
+		uint8 *entry = hashTable[index];
+		rct_track_list_file_record *fileRecord = (rct_track_list_file_record*)(entry + 1 + sizeof(rct_object_entry));
+		const char *fileName = (const char *)(fileRecord + 1);
+		if (strcmp(fileName, fileInfo->path) == 0) {
+			if (fileRecord->size == fileInfo->size && fileRecord->last_modified == fileInfo->last_modified)
+				return entry;
+			return NULL;
+		}
+
+		index++;
+		if (index >= hashTableSize) index = 0;
+	}
+	return NULL;
+}
+
 /**
  *
  *  rct2: 0x006CED50
@@ -421,42 +570,68 @@ void track_load_list(ride_list_item item)
 
 	uint8* track_list_cache;
 
-	if (item.type == 0xFC || !(track_list_cache = track_list_cache_load(totalFiles))){
-		uint8* new_track_file;
-
-		new_track_file = malloc(0x40000);
-
+	if (item.type == 0xFC || !(track_list_cache = track_list_cache_load(totalFiles, NULL))){
+		// Entries of files that have not changed since the previous cache are reused rather than decoded again
+		int previousFileCount = 0;
+		uint32 previousHashTableSize = 0;
+		uint8 **previousHashTable = NULL;
+		uint8 *previous_track_list_cache = track_list_cache_load(totalFiles, &previousFileCount);
+		if (previous_track_list_cache != NULL)
+			previousHashTable = track_list_create_path_hash_table(previous_track_list_cache, previousFileCount, &previousHashTableSize);
+
+		size_t new_track_file_capacity = 0x10000;
+		uint8* new_track_file = malloc(new_track_file_capacity);
 		uint8* new_file_pointer = new_track_file;
 		file_info enumFileInfo;
 
 		int enumFileHandle = platform_enumerate_files_begin(RCT2_ADDRESS(RCT2_ADDRESS_TRACKS_PATH, char));
 		if (enumFileHandle == INVALID_HANDLE)
 		{
-			free(new_file_pointer);
+			free(new_track_file);
+			free(previousHashTable);
+			free(previous_track_list_cache);
 			return;
 		}
 
 		while (platform_enumerate_files_next(enumFileHandle, &enumFileInfo)) {
-			if (new_file_pointer > new_track_file + 0x3FF00)break;
+			// Grow the buffer so that there is always room for the next entry and the end marker
+			size_t offset = new_file_pointer - new_track_file;
+			if (offset + TRACK_LIST_CACHE_MAX_ENTRY_SIZE + 1 > new_track_file_capacity) {
+				new_track_file_capacity *= 2;
+				new_track_file = realloc(new_track_file, new_track_file_capacity);
+				new_file_pointer = new_track_file + offset;
+			}
 
-			char path[MAX_PATH];
-			substitute_path(path, RCT2_ADDRESS(RCT2_ADDRESS_TRACKS_PATH, char), enumFileInfo.path);
+			uint8 *previousEntry = NULL;
+			if (previousHashTable != NULL)
+				previousEntry = track_list_find_unchanged_entry(previousHashTable, previousHashTableSize, &enumFileInfo);
 
-			rct_track_td6* loaded_track = load_track_design(path);
-			if (loaded_track){
-				*new_file_pointer++ = loaded_track->type;
-			}
-			else{
-				*new_file_pointer++ = 0xFF;
-				// Garbage object
+			if (previousEntry != NULL) {
+				*new_file_pointer++ = *previousEntry;
+				memcpy(new_file_pointer, previousEntry + 1, sizeof(rct_object_entry));
+				new_file_pointer += sizeof(rct_object_entry);
+			} else {
+				char path[MAX_PATH];
+				substitute_path(path, RCT2_ADDRESS(RCT2_ADDRESS_TRACKS_PATH, char), enumFileInfo.path);
+
+				uint8 trackType;
+				rct_object_entry vehicleObject;
+				if (track_design_read_header(path, &trackType, &vehicleObject)) {
+					*new_file_pointer++ = trackType;
+					memcpy(new_file_pointer, &vehicleObject, sizeof(rct_object_entry));
+				} else {
+					*new_file_pointer++ = 0xFF;
+					// Garbage object
+					memset(new_file_pointer, 0xFF, sizeof(rct_object_entry));
+				}
 				new_file_pointer += sizeof(rct_object_entry);
-				// Empty string
-				*new_file_pointer++ = '\0';
-				// Unsure why it previously didn't continue on load fail??
-				continue;
 			}
-			memcpy(new_file_pointer, &loaded_track->vehicle_object, sizeof(rct_object_entry));
-			new_file_pointer += sizeof(rct_object_entry);
+
+			rct_track_list_file_record fileRecord;
+			fileRecord.size = enumFileInfo.size;
+			fileRecord.last_modified = enumFileInfo.last_modified;
+			memcpy(new_file_pointer, &fileRecord, sizeof(rct_track_list_file_record));
+			new_file_pointer += sizeof(rct_track_list_file_record);
 
 			int file_name_length = strlen(enumFileInfo.path);
 			strcpy((char *)new_file_pointer, enumFileInfo.path);
@@ -464,17 +639,15 @@ void track_load_list(ride_list_item item)
 		}
 		platform_enumerate_files_end(enumFileHandle);
 
+		free(previousHashTable);
+		free(previous_track_list_cache);
+
 		if (!track_list_cache_save(totalFiles, new_track_file, new_file_pointer - new_track_file)){
 			log_error("Track list failed to save.");
-			return;
 		}
-		free(new_track_file);
 
-		track_list_cache = track_list_cache_load(totalFiles);
-		if (!track_list_cache){
-			log_error("Track list failed to load after new save");
-			return;
-		}
+		*new_file_pointer = 0xFE;
+		track_list_cache = new_track_file;
 	}
 
 	track_list_populate(item, track_list_cache);
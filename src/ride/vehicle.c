@@ -161,6 +161,24 @@ const rct_vehicle_info *vehicle_get_move_info(int cd, int typeAndDirection, int
 	return &infoList[offset];
 }
 
+/**
+ * The number of move info entries (track progress steps) in a move info list, stored in the two bytes
+ * before the list.
+ */
+static uint16 vehicle_move_info_list_get_size(const rct_vehicle_info *moveInfoList)
+{
+	return ((const uint16*)moveInfoList)[-1];
+}
+
+/**
+ * The number of move info entries (track progress steps) for a track piece.
+ */
+uint16 vehicle_get_move_info_size(int cd, int typeAndDirection)
+{
+	const rct_vehicle_info **infoListList = RCT2_ADDRESS(0x008B8F30, const rct_vehicle_info**)[cd];
+	return vehicle_move_info_list_get_size(infoListList[typeAndDirection]);
+}
+
 const uint8 DoorOpenSoundIds[] = {
 	SOUND_DOOR_OPEN,
 	SOUND_62
@@ -227,94 +245,114 @@ void vehicle_invalidate(rct_vehicle *vehicle)
 	invalidate_sprite_2((rct_sprite*)vehicle);
 }
 
+typedef struct {
+	sint16 left;
+	sint16 top;
+	sint16 right;
+	sint16 bottom;
+} rct_vehicle_sound_bounds;
+
+/**
+ * Gets the view area in which vehicles can be heard. The main window also hears vehicles up to a quarter of the
+ * view size outside of the view.
+ */
+static void vehicle_sounds_get_bounds(rct_viewport *viewport, rct_window *window, rct_vehicle_sound_bounds *outBounds)
+{
+	sint16 x = viewport->view_x;
+	sint16 y = viewport->view_y;
+	sint16 w = viewport->view_width / 4;
+	sint16 h = viewport->view_height / 4;
+	if (!window->classification) {
+		x -= w;
+		y -= h;
+	}
+
+	sint16 w2 = viewport->view_width + x;
+	sint16 h2 = viewport->view_height + y;
+	if (!window->classification) {
+		w2 += w + w;
+		h2 += h + h;
+	}
+
+	outBounds->left = x;
+	outBounds->top = y;
+	outBounds->right = w2;
+	outBounds->bottom = h2;
+}
+
 /**
  *
  *  rct2: 0x006BB9FF
  */
-void vehicle_update_sound_params(rct_vehicle* vehicle)
+static void vehicle_update_sound_params(rct_vehicle* vehicle, const rct_vehicle_sound_bounds *bounds)
 {
-	if (!(gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) && (!(gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) || RCT2_GLOBAL(0x0141F570, uint8) == 6)) {
-		if (vehicle->sound1_id != (uint8)-1 || vehicle->sound2_id != (uint8)-1) {
-			if (vehicle->sprite_left != (sint16)0x8000) {
-				sint16 x = RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_x;
-				sint16 y = RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_y;
-				sint16 w = RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_width / 4;
-				sint16 h = RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_height / 4;
-				if (!RCT2_GLOBAL(0x00F438A8, rct_window*)->classification) {
-					x -= w;
-					y -= h;
-				}
-				if (x < vehicle->sprite_right && y < vehicle->sprite_bottom) {
-					sint16 w2 = RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_width + x;
-					sint16 h2 = RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_height + y;
-					if (!RCT2_GLOBAL(0x00F438A8, rct_window*)->classification) {
-						w2 += w + w;
-						h2 += h + h;
-					}
-					if (w2 >= vehicle->sprite_left && h2 >= vehicle->sprite_top) {
-						uint16 v9 = sub_6BC2F3(vehicle);
-						rct_vehicle_sound_params* i;
-						for (i = &gVehicleSoundParamsList[0]; i < gVehicleSoundParamsListEnd && v9 <= i->var_A; i++);
-						if (i < &gVehicleSoundParamsList[countof(gVehicleSoundParamsList)]) {
-							if (gVehicleSoundParamsListEnd < &gVehicleSoundParamsList[countof(gVehicleSoundParamsList)]) {
-								gVehicleSoundParamsListEnd++;
-							}
-							rct_vehicle_sound_params* j = gVehicleSoundParamsListEnd - 1;
-							while (j >= i) {
-								j--;
-								*(j + 1) = *j;
-							}
-							i->var_A = v9;
-							int pan_x = (vehicle->sprite_left / 2) + (vehicle->sprite_right / 2) - RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_x;
-							pan_x >>= RCT2_GLOBAL(0x00F438A4, rct_viewport*)->zoom;
-							pan_x += RCT2_GLOBAL(0x00F438A4, rct_viewport*)->x;
-
-							uint16 screenwidth = gScreenWidth;
-							if (screenwidth < 64) {
-								screenwidth = 64;
-							}
-							i->pan_x = ((((pan_x << 16) / screenwidth) - 0x8000) >> 4);
+	if (vehicle->sound1_id == (uint8)-1 && vehicle->sound2_id == (uint8)-1)
+		return;
+	if (vehicle->sprite_left == (sint16)0x8000)
+		return;
+	if (bounds->left >= vehicle->sprite_right || bounds->top >= vehicle->sprite_bottom)
+		return;
+	if (bounds->right < vehicle->sprite_left || bounds->bottom < vehicle->sprite_top)
+		return;
 
-							int pan_y = (vehicle->sprite_top / 2) + (vehicle->sprite_bottom / 2) - RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_y;
-							pan_y >>= RCT2_GLOBAL(0x00F438A4, rct_viewport*)->zoom;
-							pan_y += RCT2_GLOBAL(0x00F438A4, rct_viewport*)->y;
+	uint16 v9 = sub_6BC2F3(vehicle);
+	rct_vehicle_sound_params* i;
+	for (i = &gVehicleSoundParamsList[0]; i < gVehicleSoundParamsListEnd && v9 <= i->var_A; i++);
+	if (i < &gVehicleSoundParamsList[countof(gVehicleSoundParamsList)]) {
+		if (gVehicleSoundParamsListEnd < &gVehicleSoundParamsList[countof(gVehicleSoundParamsList)]) {
+			gVehicleSoundParamsListEnd++;
+		}
+		rct_vehicle_sound_params* j = gVehicleSoundParamsListEnd - 1;
+		while (j >= i) {
+			j--;
+			*(j + 1) = *j;
+		}
+		i->var_A = v9;
+		int pan_x = (vehicle->sprite_left / 2) + (vehicle->sprite_right / 2) - RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_x;
+		pan_x >>= RCT2_GLOBAL(0x00F438A4, rct_viewport*)->zoom;
+		pan_x += RCT2_GLOBAL(0x00F438A4, rct_viewport*)->x;
 
-							uint16 screenheight = gScreenHeight;
-							if (screenheight < 64) {
-								screenheight = 64;
-							}
-							i->pan_y = ((((pan_y << 16) / screenheight) - 0x8000) >> 4);
+		uint16 screenwidth = gScreenWidth;
+		if (screenwidth < 64) {
+			screenwidth = 64;
+		}
+		i->pan_x = ((((pan_x << 16) / screenwidth) - 0x8000) >> 4);
 
-							sint32 v = vehicle->velocity;
+		int pan_y = (vehicle->sprite_top / 2) + (vehicle->sprite_bottom / 2) - RCT2_GLOBAL(0x00F438A4, rct_viewport*)->view_y;
+		pan_y >>= RCT2_GLOBAL(0x00F438A4, rct_viewport*)->zoom;
+		pan_y += RCT2_GLOBAL(0x00F438A4, rct_viewport*)->y;
 
-							rct_ride_entry* ride_type = get_ride_entry(vehicle->ride_subtype);
-							uint8 test = ride_type->vehicles[vehicle->vehicle_type].var_5A;
+		uint16 screenheight = gScreenHeight;
+		if (screenheight < 64) {
+			screenheight = 64;
+		}
+		i->pan_y = ((((pan_y << 16) / screenheight) - 0x8000) >> 4);
 
-							if (test & 1) {
-								v *= 2;
-							}
-							if (v < 0) {
-								v = -v;
-							}
-							v >>= 5;
-							v *= 5512;
-							v >>= 14;
-							v += 11025;
-							v += 16 * vehicle->var_BF;
-							i->frequency = (uint16)v;
-							i->id = vehicle->sprite_index;
-							i->volume = 0;
-							if (vehicle->x != (sint16)0x8000) {
-								int tile_idx = (((vehicle->y & 0xFFE0) * 256) + (vehicle->x & 0xFFE0)) / 32;
-								rct_map_element* map_element;
-								for (map_element = RCT2_ADDRESS(RCT2_ADDRESS_TILE_MAP_ELEMENT_POINTERS, rct_map_element*)[tile_idx]; map_element->type & MAP_ELEMENT_TYPE_MASK; map_element++);
-								if (map_element->base_height * 8 > vehicle->z) { // vehicle underground
-									i->volume = 0x30;
-								}
-							}
-						}
-					}
-				}
+		sint32 v = vehicle->velocity;
+
+		rct_ride_entry* ride_type = get_ride_entry(vehicle->ride_subtype);
+		uint8 test = ride_type->vehicles[vehicle->vehicle_type].var_5A;
+
+		if (test & 1) {
+			v *= 2;
+		}
+		if (v < 0) {
+			v = -v;
+		}
+		v >>= 5;
+		v *= 5512;
+		v >>= 14;
+		v += 11025;
+		v += 16 * vehicle->var_BF;
+		i->frequency = (uint16)v;
+		i->id = vehicle->sprite_index;
+		i->volume = 0;
+		if (vehicle->x != (sint16)0x8000) {
+			int tile_idx = (((vehicle->y & 0xFFE0) * 256) + (vehicle->x & 0xFFE0)) / 32;
+			rct_map_element* map_element;
+			for (map_element = RCT2_ADDRESS(RCT2_ADDRESS_TILE_MAP_ELEMENT_POINTERS, rct_map_element*)[tile_idx]; map_element->type & MAP_ELEMENT_TYPE_MASK; map_element++);
+			if (map_element->base_height * 8 > vehicle->z) { // vehicle underground
+				i->volume = 0x30;
 			}
 		}
 	}
@@ -348,6 +386,26 @@ int sub_6BC2F3(rct_vehicle* vehicle)
 	return result + 300;
 }
 
+static rct_vehicle_sound_params *vehicle_sounds_find_params(uint16 spriteIndex)
+{
+	for (rct_vehicle_sound_params* vehicle_sound_params = &gVehicleSoundParamsList[0]; vehicle_sound_params < gVehicleSoundParamsListEnd; vehicle_sound_params++) {
+		if (vehicle_sound_params->id == spriteIndex) {
+			return vehicle_sound_params;
+		}
+	}
+	return NULL;
+}
+
+static rct_vehicle_sound *vehicle_sounds_find_free()
+{
+	for (int i = 0; i < countof(gVehicleSoundList); i++) {
+		if (gVehicleSoundList[i].id == (uint16)-1) {
+			return &gVehicleSoundList[i];
+		}
+	}
+	return NULL;
+}
+
 /**
  *
  *  rct2: 0x006BBC6B
@@ -381,17 +439,29 @@ void vehicle_sounds_update()
 				}
 			}
 			gVehicleSoundParamsListEnd = &gVehicleSoundParamsList[0];
-			for (uint16 i = RCT2_GLOBAL(RCT2_ADDRESS_SPRITES_START_VEHICLE, uint16); i != SPRITE_INDEX_NULL; i = g_sprite_list[i].vehicle.next) {
-				vehicle_update_sound_params(&g_sprite_list[i].vehicle);
+			// If no window has a sound viewport, window is before the start of the window list, so no vehicle is heard
+			if (viewport != NULL && window >= g_window_list &&
+				!(gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) && (!(gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) || RCT2_GLOBAL(0x0141F570, uint8) == 6)
+			) {
+				// The view area is worked out once rather than for every vehicle
+				rct_vehicle_sound_bounds bounds;
+				vehicle_sounds_get_bounds(viewport, window, &bounds);
+				for (uint16 i = RCT2_GLOBAL(RCT2_ADDRESS_SPRITES_START_VEHICLE, uint16); i != SPRITE_INDEX_NULL; i = g_sprite_list[i].vehicle.next) {
+					vehicle_update_sound_params(&g_sprite_list[i].vehicle, &bounds);
+				}
 			}
+
+			// Match the playing sounds to the new sound params once, stopping sounds of vehicles no longer heard
+			rct_vehicle_sound *paramsVehicleSound[AUDIO_MAX_VEHICLE_SOUNDS] = { 0 };
 			for(int i = 0; i < countof(gVehicleSoundList); i++){
 				rct_vehicle_sound* vehicle_sound = &gVehicleSoundList[i];
 				if (vehicle_sound->id != (uint16)-1) {
-					for (rct_vehicle_sound_params* vehicle_sound_params = &gVehicleSoundParamsList[0]; vehicle_sound_params != gVehicleSoundParamsListEnd; vehicle_sound_params++) {
-						if (vehicle_sound->id == vehicle_sound_params->id) {
-							goto label26;
-						}
+					rct_vehicle_sound_params* vehicle_sound_params = vehicle_sounds_find_params(vehicle_sound->id);
+					if (vehicle_sound_params != NULL) {
+						paramsVehicleSound[vehicle_sound_params - gVehicleSoundParamsList] = vehicle_sound;
+						continue;
 					}
+
 					if (vehicle_sound->sound1_id != (uint16)-1) {
 						Mixer_Stop_Channel(vehicle_sound->sound1_channel);
 					}
@@ -400,15 +470,9 @@ void vehicle_sounds_update()
 					}
 					vehicle_sound->id = (uint16)-1;
 				}
-			label26:
-				;
 			}
 
-			for (rct_vehicle_sound_params* vehicle_sound_params = &gVehicleSoundParamsList[0]; ; vehicle_sound_params++) {
-			label28:
-				if (vehicle_sound_params >= gVehicleSoundParamsListEnd) {
-					return;
-				}
+			for (rct_vehicle_sound_params* vehicle_sound_params = &gVehicleSoundParamsList[0]; vehicle_sound_params < gVehicleSoundParamsListEnd; vehicle_sound_params++) {
 				uint8 vol1 = 0xFF;
 				uint8 vol2 = 0xFF;
 				sint16 pan_y = vehicle_sound_params->pan_y;
@@ -462,26 +526,17 @@ void vehicle_sounds_update()
 					vol1 = vol1 - gVolumeAdjustZoom;
 				}
 
-				rct_vehicle_sound* vehicle_sound = &gVehicleSoundList[0];
-				while (vehicle_sound_params->id != vehicle_sound->id) {
-					vehicle_sound++;
-					if (vehicle_sound >= &gVehicleSoundList[countof(gVehicleSoundList)]) {
-						vehicle_sound = &gVehicleSoundList[0];
-						int i = 0;
-						while (vehicle_sound->id != (uint16)-1) {
-							vehicle_sound++;
-							i++;
-							if (i >= countof(gVehicleSoundList)) {
-								vehicle_sound_params = (rct_vehicle_sound_params*)((int)vehicle_sound_params + 10);
-								goto label28;
-							}
-						}
-						vehicle_sound->id = vehicle_sound_params->id;
-						vehicle_sound->sound1_id = (uint16)-1;
-						vehicle_sound->sound2_id = (uint16)-1;
-						vehicle_sound->volume = 0x30;
-						break;
+				rct_vehicle_sound* vehicle_sound = paramsVehicleSound[vehicle_sound_params - gVehicleSoundParamsList];
+				if (vehicle_sound == NULL) {
+					// Start a new sound in a free slot, if there is one
+					vehicle_sound = vehicle_sounds_find_free();
+					if (vehicle_sound == NULL) {
+						continue;
 					}
+					vehicle_sound->id = vehicle_sound_params->id;
+					vehicle_sound->sound1_id = (uint16)-1;
+					vehicle_sound->sound2_id = (uint16)-1;
+					vehicle_sound->volume = 0x30;
 				}
 
 				int tempvolume = vehicle_sound->volume;
@@ -635,6 +690,10 @@ void vehicle_update_all()
 		vehicle = &(g_sprite_list[sprite_index].vehicle);
 		sprite_index = vehicle->next;
 
+		// Trains are spread across the sprite list, fetch the next one while this one updates
+		if (sprite_index != SPRITE_INDEX_NULL)
+			PREFETCH(&g_sprite_list[sprite_index]);
+
 		vehicle_update(vehicle);
 	}
 }
@@ -6952,30 +7011,32 @@ loc_6DAEB9:
 
 	regs.ax = vehicle->track_progress + 1;
 
-	const rct_vehicle_info *moveInfo = vehicle_get_move_info(
+	// This runs for every step of every car, so only look up the move info list again when the car
+	// has moved on to a new track piece
+	const rct_vehicle_info *moveInfoList = vehicle_get_move_info(
 		vehicle->var_CD,
 		vehicle->track_type,
 		0
 		);
 
-	// Track Total Progress is in the two bytes before the move info list
-	uint16 trackTotalProgress = *((uint16*)((int)moveInfo - 2));
+	uint16 trackTotalProgress = vehicle_move_info_list_get_size(moveInfoList);
 	if (regs.ax >= trackTotalProgress) {
 		if (!vehicle_update_track_motion_forwards_get_new_track(vehicle, trackType, ride, rideEntry)) {
 			goto loc_6DB94A;
 		}
 		regs.ax = 0;
+		moveInfoList = vehicle_get_move_info(
+			vehicle->var_CD,
+			vehicle->track_type,
+			0
+			);
 	}
 
 	vehicle->track_progress = regs.ax;
 	vehicle_update_handle_water_splash(vehicle);
 
 	// loc_6DB706
-	moveInfo = vehicle_get_move_info(
-		vehicle->var_CD,
-		vehicle->track_type,
-		vehicle->track_progress
-		);
+	const rct_vehicle_info *moveInfo = &moveInfoList[vehicle->track_progress];
 	sint16 x = vehicle->track_x + moveInfo->x;
 	sint16 y = vehicle->track_y + moveInfo->y;
 	sint16 z = vehicle->track_z + moveInfo->z + RideData5[ride->type].z_offset;
@@ -7233,14 +7294,7 @@ bool vehicle_update_track_motion_backwards_get_new_track(rct_vehicle *vehicle, u
 	vehicle->track_direction |= direction;
 	vehicle->break_speed = (mapElement->properties.track.sequence >> 4) << 1;
 
-	const rct_vehicle_info* moveInfo = vehicle_get_move_info(
-		vehicle->var_CD,
-		vehicle->track_type,
-		0
-		);
-
-	// There are two bytes before the move info list
-	uint16 trackTotalProgress = *((uint16*)((int)moveInfo - 2));
+	uint16 trackTotalProgress = vehicle_get_move_info_size(vehicle->var_CD, vehicle->track_type);
 	*progress = trackTotalProgress - 1;
 	return true;
 }
@@ -7474,10 +7528,9 @@ loc_6DC476:
 	// loc_6DC5B8
 	const rct_vehicle_info* moveInfo = vehicle_get_move_info(vehicle->var_CD, vehicle->track_type, 0);
 
-	// There are two bytes before the move info list
 	{
 		uint16 unk16_v34 = vehicle->track_progress + 1;
-		uint16 unk16 = *((uint16*)((int)moveInfo - 2));
+		uint16 unk16 = vehicle_move_info_list_get_size(moveInfo);
 		if (unk16_v34 < unk16) {
 			regs.ax = unk16_v34;
 			goto loc_6DC743;
@@ -7751,8 +7804,7 @@ loc_6DCA9A:
 
 	moveInfo = vehicle_get_move_info(vehicle->var_CD, vehicle->track_type, 0);
 
-	// There are two bytes before the move info list
-	regs.ax = *((uint16*)((int)moveInfo - 2)) - 1;
+	regs.ax = vehicle_move_info_list_get_size(moveInfo) - 1;
 
 loc_6DCC2C:
 	vehicle->track_progress = regs.ax;
@@ -374,6 +374,7 @@ void vehicle_peep_easteregg_here_we_are(rct_vehicle* vehicle);
 rct_vehicle *vehicle_get_head(rct_vehicle *vehicle);
 rct_vehicle *vehicle_get_tail(rct_vehicle *vehicle);
 const rct_vehicle_info *vehicle_get_move_info(int cd, int typeAndDirection, int offset);
+uint16 vehicle_get_move_info_size(int cd, int typeAndDirection);
 bool vehicle_update_bumper_car_collision(rct_vehicle *vehicle, sint16 x, sint16 y, uint16 *spriteId);
 
 /** Helper macro until rides are stored in this module. */
@@ -18,6 +18,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *****************************************************************************/
 
+#include <ctype.h>
 #include "addresses.h"
 #include "config.h"
 #include "localisation/localisation.h"
@@ -34,8 +35,49 @@ int gScenarioHighscoreListCount = 0;
 int gScenarioHighscoreListCapacity = 0;
 scenario_highscore_entry *gScenarioHighscoreList = NULL;
 
+#define SCENARIO_INDEX_CACHE_VERSION 1
+
+// Decoded header information of a scenario file, keyed by path, size and modification date
+typedef struct {
+	utf8 path[MAX_PATH];
+	uint64 size;
+	uint64 last_modified;
+	uint8 valid;
+	rct_s6_info info;
+} scenario_cache_entry;
+
+// Open addressing hash table of indices into a list, keyed by a case insensitive string
+typedef struct {
+	uint32 *slots;
+	uint32 capacity;
+	uint32 count;
+	const utf8 *(*get_key)(int index);
+} scenario_lookup_table;
+
+// Cache read from disk and the cache being built by the current scan
+static scenario_cache_entry *_scenarioCache = NULL;
+static int _scenarioCacheCount = 0;
+static scenario_cache_entry *_scenarioCacheNew = NULL;
+static int _scenarioCacheNewCount = 0;
+static int _scenarioCacheNewCapacity = 0;
+static bool _scenarioCacheDirty = false;
+
+static const utf8 *scenario_list_get_filename_key(int index);
+static const utf8 *scenario_cache_get_path_key(int index);
+static scenario_lookup_table _scenarioFilenameTable = { NULL, 0, 0, scenario_list_get_filename_key };
+static scenario_lookup_table _scenarioCacheTable = { NULL, 0, 0, scenario_cache_get_path_key };
+
 static void scenario_list_include(const utf8 *directory);
-static void scenario_list_add(const utf8 *path, uint64 timestamp);
+static void scenario_list_add(const utf8 *path, uint64 size, uint64 timestamp);
+static bool scenario_list_get_info(const utf8 *path, uint64 size, uint64 timestamp, rct_s6_info *outInfo);
+static void scenario_list_rebuild_lookup();
+static void scenario_cache_get_path(utf8 *outPath);
+static void scenario_cache_load();
+static void scenario_cache_save();
+static void scenario_cache_dispose();
+static void lookup_table_clear(scenario_lookup_table *table);
+static void lookup_table_insert(scenario_lookup_table *table, int index);
+static int lookup_table_find(const scenario_lookup_table *table, const utf8 *key);
 static void scenario_list_sort();
 static int scenario_list_sort_by_category(const void *a, const void *b);
 static int scenario_list_sort_by_index(const void *a, const void *b);
@@ -58,6 +100,9 @@ void scenario_load_list()
 
 	// Clear scenario list
 	gScenarioListCount = 0;
+	lookup_table_clear(&_scenarioFilenameTable);
+
+	scenario_cache_load();
 
 	// Get scenario directory from RCT2
 	safe_strcpy(directory, gConfigGeneral.game_path, sizeof(directory));
@@ -68,7 +113,13 @@ void scenario_load_list()
 	platform_get_user_directory(directory, "scenario");
 	scenario_list_include(directory);
 
+	if (_scenarioCacheDirty || _scenarioCacheNewCount != _scenarioCacheCount) {
+		scenario_cache_save();
+	}
+	scenario_cache_dispose();
+
 	scenario_list_sort();
+	scenario_list_rebuild_lookup();
 	scenario_scores_load();
 
 	utf8 scoresPath[MAX_PATH];
@@ -92,7 +143,7 @@ static void scenario_list_include(const utf8 *directory)
 		utf8 path[MAX_PATH];
 		safe_strcpy(path, directory, sizeof(pattern));
 		safe_strcat_path(path, fileInfo.path, sizeof(pattern));
-		scenario_list_add(path, fileInfo.last_modified);
+		scenario_list_add(path, fileInfo.size, fileInfo.last_modified);
 	}
 	platform_enumerate_files_end(handle);
 
@@ -108,12 +159,11 @@ static void scenario_list_include(const utf8 *directory)
 	platform_enumerate_directories_end(handle);
 }
 
-static void scenario_list_add(const utf8 *path, uint64 timestamp)
+static void scenario_list_add(const utf8 *path, uint64 size, uint64 timestamp)
 {
 	// Load the basic scenario information
-	rct_s6_header s6Header;
 	rct_s6_info s6Info;
-	if (!scenario_load_basic(path, &s6Header, &s6Info)) {
+	if (!scenario_list_get_info(path, size, timestamp, &s6Info)) {
 		return;
 	}
 
@@ -153,6 +203,9 @@ static void scenario_list_add(const utf8 *path, uint64 timestamp)
 
 	// Set new entry
 	safe_strcpy(newEntry->path, path, sizeof(newEntry->path));
+	if (existingEntry == NULL) {
+		lookup_table_insert(&_scenarioFilenameTable, gScenarioListCount - 1);
+	}
 	newEntry->timestamp = timestamp;
 	newEntry->category = s6Info.category;
 	newEntry->objective_type = s6Info.objective_type;
@@ -186,6 +239,43 @@ static void scenario_list_add(const utf8 *path, uint64 timestamp)
 	scenario_translate(newEntry, &s6Info.entry);
 }
 
+/**
+ * Gets the information chunk of a scenario file, from the index cache if the file has not changed since it was
+ * cached, otherwise by decoding the file. Either way the result is recorded in the cache for the next scan.
+ */
+static bool scenario_list_get_info(const utf8 *path, uint64 size, uint64 timestamp, rct_s6_info *outInfo)
+{
+	if (_scenarioCacheNewCount == _scenarioCacheNewCapacity) {
+		_scenarioCacheNewCapacity = max(8, _scenarioCacheNewCapacity * 2);
+		_scenarioCacheNew = realloc(_scenarioCacheNew, _scenarioCacheNewCapacity * sizeof(scenario_cache_entry));
+	}
+	scenario_cache_entry *newCacheEntry = &_scenarioCacheNew[_scenarioCacheNewCount++];
+
+	int cacheIndex = lookup_table_find(&_scenarioCacheTable, path);
+	if (cacheIndex != -1) {
+		const scenario_cache_entry *cacheEntry = &_scenarioCache[cacheIndex];
+		if (cacheEntry->size == size && cacheEntry->last_modified == timestamp && strcmp(cacheEntry->path, path) == 0) {
+			*newCacheEntry = *cacheEntry;
+			*outInfo = cacheEntry->info;
+			return cacheEntry->valid != 0;
+		}
+	}
+
+	rct_s6_header s6Header;
+	bool valid = scenario_load_basic(path, &s6Header, outInfo);
+
+	memset(newCacheEntry, 0, sizeof(scenario_cache_entry));
+	safe_strcpy(newCacheEntry->path, path, sizeof(newCacheEntry->path));
+	newCacheEntry->size = size;
+	newCacheEntry->last_modified = timestamp;
+	newCacheEntry->valid = valid ? 1 : 0;
+	if (valid) {
+		newCacheEntry->info = *outInfo;
+	}
+	_scenarioCacheDirty = true;
+	return valid;
+}
+
 static void scenario_translate(scenario_index_entry *scenarioEntry, const rct_object_entry *stexObjectEntry)
 {
 	rct_string_id localisedStringIds[3];
@@ -214,6 +304,183 @@ void scenario_list_dispose()
 	gScenarioListCapacity = 0;
 	gScenarioListCount = 0;
 	SafeFree(gScenarioList);
+	lookup_table_clear(&_scenarioFilenameTable);
+	SafeFree(_scenarioFilenameTable.slots);
+	_scenarioFilenameTable.capacity = 0;
+}
+
+static const utf8 *scenario_list_get_filename_key(int index)
+{
+	return path_get_filename(gScenarioList[index].path);
+}
+
+/**
+ * Re-indexes the filename lookup, required after the list has been reordered.
+ */
+static void scenario_list_rebuild_lookup()
+{
+	lookup_table_clear(&_scenarioFilenameTable);
+	for (int i = 0; i < gScenarioListCount; i++) {
+		lookup_table_insert(&_scenarioFilenameTable, i);
+	}
+}
+
+static const utf8 *scenario_cache_get_path_key(int index)
+{
+	return _scenarioCache[index].path;
+}
+
+static void scenario_cache_get_path(utf8 *outPath)
+{
+	platform_get_user_directory(outPath, NULL);
+	strcat(outPath, "scenarios.idx");
+}
+
+/**
+ * Loads the scenario index cache so that unchanged scenario files do not need to be decoded again.
+ */
+static void scenario_cache_load()
+{
+	scenario_cache_dispose();
+
+	utf8 path[MAX_PATH];
+	scenario_cache_get_path(path);
+
+	SDL_RWops *file = SDL_RWFromFile(path, "rb");
+	if (file == NULL) {
+		return;
+	}
+
+	uint32 fileVersion, count;
+	if (
+		SDL_RWread(file, &fileVersion, sizeof(fileVersion), 1) != 1 ||
+		fileVersion != SCENARIO_INDEX_CACHE_VERSION ||
+		SDL_RWread(file, &count, sizeof(count), 1) != 1
+	) {
+		SDL_RWclose(file);
+		log_verbose("Invalid or incompatible scenario index cache.");
+		return;
+	}
+
+	if (count > 0) {
+		_scenarioCache = malloc(count * sizeof(scenario_cache_entry));
+		if (_scenarioCache == NULL || SDL_RWread(file, _scenarioCache, count * sizeof(scenario_cache_entry), 1) != 1) {
+			SDL_RWclose(file);
+			SafeFree(_scenarioCache);
+			log_verbose("Invalid or incompatible scenario index cache.");
+			return;
+		}
+		_scenarioCacheCount = (int)count;
+	}
+	SDL_RWclose(file);
+
+	for (int i = 0; i < _scenarioCacheCount; i++) {
+		_scenarioCache[i].path[MAX_PATH - 1] = '\0';
+		lookup_table_insert(&_scenarioCacheTable, i);
+	}
+}
+
+static void scenario_cache_save()
+{
+	utf8 path[MAX_PATH];
+	scenario_cache_get_path(path);
+
+	SDL_RWops *file = SDL_RWFromFile(path, "wb");
+	if (file == NULL) {
+		log_error("Unable to save scenario index cache.");
+		return;
+	}
+
+	const uint32 fileVersion = SCENARIO_INDEX_CACHE_VERSION;
+	uint32 count = (uint32)_scenarioCacheNewCount;
+	SDL_RWwrite(file, &fileVersion, sizeof(fileVersion), 1);
+	SDL_RWwrite(file, &count, sizeof(count), 1);
+	if (count > 0) {
+		SDL_RWwrite(file, _scenarioCacheNew, count * sizeof(scenario_cache_entry), 1);
+	}
+	SDL_RWclose(file);
+}
+
+static void scenario_cache_dispose()
+{
+	SafeFree(_scenarioCache);
+	_scenarioCacheCount = 0;
+	SafeFree(_scenarioCacheNew);
+	_scenarioCacheNewCount = 0;
+	_scenarioCacheNewCapacity = 0;
+	_scenarioCacheDirty = false;
+	lookup_table_clear(&_scenarioCacheTable);
+	SafeFree(_scenarioCacheTable.slots);
+	_scenarioCacheTable.capacity = 0;
+}
+
+static uint32 lookup_table_hash(const utf8 *key)
+{
+	// FNV-1a over the lower case bytes so that it agrees with _strcmpi
+	uint32 hash = 2166136261u;
+	for (const utf8 *ch = key; *ch != '\0'; ch++) {
+		hash ^= (uint8)tolower((uint8)*ch);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void lookup_table_clear(scenario_lookup_table *table)
+{
+	if (table->slots != NULL) {
+		memset(table->slots, 0, table->capacity * sizeof(uint32));
+	}
+	table->count = 0;
+}
+
+/**
+ * Adds the list entry at the given index. Slots hold the index plus one so that zero marks an empty slot.
+ */
+static void lookup_table_insert(scenario_lookup_table *table, int index)
+{
+	if ((table->count + 1) * 2 > table->capacity) {
+		uint32 *oldSlots = table->slots;
+		uint32 oldCapacity = table->capacity;
+
+		table->capacity = max(64, oldCapacity * 2);
+		table->slots = calloc(table->capacity, sizeof(uint32));
+		table->count = 0;
+		for (uint32 i = 0; i < oldCapacity; i++) {
+			if (oldSlots[i] != 0) {
+				lookup_table_insert(table, oldSlots[i] - 1);
+			}
+		}
+		free(oldSlots);
+	}
+
+	uint32 mask = table->capacity - 1;
+	uint32 slot = lookup_table_hash(table->get_key(index)) & mask;
+	while (table->slots[slot] != 0) {
+		slot = (slot + 1) & mask;
+	}
+	table->slots[slot] = (uint32)index + 1;
+	table->count++;
+}
+
+/**
+ * Returns the index of the first inserted entry whose key matches, or -1.
+ */
+static int lookup_table_find(const scenario_lookup_table *table, const utf8 *key)
+{
+	if (table->count == 0) {
+		return -1;
+	}
+
+	uint32 mask = table->capacity - 1;
+	uint32 slot = lookup_table_hash(key) & mask;
+	while (table->slots[slot] != 0) {
+		int index = (int)table->slots[slot] - 1;
+		if (_strcmpi(key, table->get_key(index)) == 0) {
+			return index;
+		}
+		slot = (slot + 1) & mask;
+	}
+	return -1;
 }
 
 static void scenario_list_sort()
@@ -294,13 +561,8 @@ static int scenario_list_sort_by_index(const void *a, const void *b)
 
 scenario_index_entry *scenario_list_find_by_filename(const utf8 *filename)
 {
-	for (int i = 0; i < gScenarioListCount; i++) {
-		const utf8 *scenarioFilename = path_get_filename(gScenarioList[i].path);
-		if (_strcmpi(filename, scenarioFilename) == 0) {
-			return &gScenarioList[i];
-		}
-	}
-	return NULL;
+	int index = lookup_table_find(&_scenarioFilenameTable, filename);
+	return index == -1 ? NULL : &gScenarioList[index];
 }
 
 scenario_index_entry *scenario_list_find_by_path(const utf8 *path)
@@ -25,6 +25,7 @@
 #include "util.h"
 
 static size_t decode_chunk_rle(const uint8* src_buffer, uint8* dst_buffer, size_t length);
+static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buffer, size_t length, size_t dstSize);
 static size_t decode_chunk_repeat(uint8 *buffer, size_t length);
 static void decode_chunk_rotate(uint8 *buffer, size_t length);
 
@@ -237,6 +238,14 @@ size_t sawyercoding_decode_td6(const uint8 *src, uint8 *dst, size_t length)
 	return decode_chunk_rle(src, dst, length - 4);
 }
 
+/**
+ * Decodes only the first dstLength bytes of a track design, e.g. for reading the header.
+ */
+size_t sawyercoding_decode_td6_partial(const uint8 *src, uint8 *dst, size_t length, size_t dstLength)
+{
+	return decode_chunk_rle_with_size(src, dst, length - 4, dstLength);
+}
+
 size_t sawyercoding_encode_td6(const uint8* src, uint8* dst, size_t length){
 	size_t output_length = encode_chunk_rle(src, dst, length);
 
@@ -304,6 +313,34 @@ static size_t decode_chunk_rle(const uint8* src_buffer, uint8* dst_buffer, size_
 	return dst - dst_buffer;
 }
 
+/**
+ * Same as decode_chunk_rle but stops once dstSize bytes have been decoded.
+ */
+static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buffer, size_t length, size_t dstSize)
+{
+	size_t i, j, count;
+	uint8 *dst, *dstEnd, rleCodeByte;
+
+	dst = dst_buffer;
+	dstEnd = dst_buffer + dstSize;
+
+	for (i = 0; i < length && dst < dstEnd; i++) {
+		rleCodeByte = src_buffer[i];
+		if (rleCodeByte & 128) {
+			i++;
+			count = 257 - rleCodeByte;
+			for (j = 0; j < count && dst < dstEnd && i < length; j++)
+				*dst++ = src_buffer[i];
+		} else {
+			for (j = 0; j <= rleCodeByte && dst < dstEnd && i + 1 < length; j++)
+				*dst++ = src_buffer[++i];
+		}
+	}
+
+	// Return final size
+	return dst - dst_buffer;
+}
+
 /**
  *
  *  rct2: 0x006769F1
@@ -56,6 +56,7 @@ size_t sawyercoding_decode_sv4(const uint8 *src, uint8 *dst, size_t length);
 size_t sawyercoding_decode_sc4(const uint8 *src, uint8 *dst, size_t length);
 size_t sawyercoding_encode_sv4(const uint8 *src, uint8 *dst, size_t length);
 size_t sawyercoding_decode_td6(const uint8 *src, uint8 *dst, size_t length);
+size_t sawyercoding_decode_td6_partial(const uint8 *src, uint8 *dst, size_t length, size_t dstLength);
 size_t sawyercoding_encode_td6(const uint8 *src, uint8 *dst, size_t length);
 int sawyercoding_validate_track_checksum(const uint8* src, size_t length);
 
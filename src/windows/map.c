@@ -36,10 +36,6 @@
 #define MINIMUM_TOOL_SIZE 1
 #define MAXIMUM_TOOL_SIZE 64
 
-#define MINIMUM_MAP_SIZE_TECHNICAL 15
-#define MAXIMUM_MAP_SIZE_TECHNICAL 256
-#define MINIMUM_MAP_SIZE_PRACTICAL MINIMUM_MAP_SIZE_TECHNICAL-2
-#define MAXIMUM_MAP_SIZE_PRACTICAL MAXIMUM_MAP_SIZE_TECHNICAL-2
 
 enum {
 	PAGE_PEEPS,
@@ -172,9 +168,13 @@ static void window_map_set_peep_spawn_tool_down(int x, int y);
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
 static void map_window_set_pixels(rct_window *w);
+static void map_window_set_tile_pixel(rct_window *w, int tileX, int tileY);
 
 static void map_window_screen_to_map(int screenX, int screenY, int *mapX, int *mapY);
 
+// Rows still to be redrawn before the whole map image is up to date
+static int _fullSweepRowsLeft;
+
 /**
 *
 *  rct2: 0x0068C88A
@@ -192,7 +192,7 @@ void window_map_open()
 		return;
 	}
 
-	map_image_data = malloc(256 * 256 * sizeof(uint32));
+	map_image_data = malloc(MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL * sizeof(uint32));
 	if (map_image_data == NULL)
 		return;
 
@@ -355,6 +355,8 @@ static void window_map_mouseup(rct_window *w, int widgetIndex)
 
 			w->selected_tab = widgetIndex;
 			w->list_information_type = 0;
+			_fullSweepRowsLeft = MAXIMUM_MAP_SIZE_TECHNICAL;
+			map_minimap_clear_dirty_tiles();
 		}
 		break;
 	}
@@ -401,8 +403,19 @@ static void window_map_update(rct_window *w)
 		window_map_center_on_view_point();
 	}
 
-	for (int i = 0; i < 16; i++)
+	// Tiles that have changed are redrawn straight away. The sweep is only fast while the whole map
+	// needs redrawing, after that it just catches changes made without invalidating the tile.
+	int tileX, tileY;
+	while (map_minimap_pop_dirty_tile(&tileX, &tileY))
+		map_window_set_tile_pixel(w, tileX, tileY);
+
+	if (_fullSweepRowsLeft > 0) {
+		for (int i = 0; i < 16; i++)
+			map_window_set_pixels(w);
+		_fullSweepRowsLeft -= 16;
+	} else {
 		map_window_set_pixels(w);
+	}
 
 	window_invalidate(w);
 
@@ -532,8 +545,8 @@ static void window_map_scrollmousedown(rct_window *w, int scrollIndex, int x, in
 	rct_window *mainWindow;
 
 	map_window_screen_to_map(x, y, &mapX, &mapY);
-	mapX = clamp(0, mapX, 8191);
-	mapY = clamp(0, mapY, 8191);
+	mapX = clamp(0, mapX, MAXIMUM_MAP_SIZE_BIG - 1);
+	mapY = clamp(0, mapY, MAXIMUM_MAP_SIZE_BIG - 1);
 	mapZ = map_element_height(x, y);
 
 	mainWindow = window_get_main();
@@ -864,8 +877,10 @@ static void window_map_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, int sc
  */
 static void window_map_init_map()
 {
-	memset(RCT2_GLOBAL(RCT2_ADDRESS_MAP_IMAGE_DATA, void*), 0x0A, 256 * 256 * sizeof(uint32));
+	memset(RCT2_GLOBAL(RCT2_ADDRESS_MAP_IMAGE_DATA, void*), 0x0A, MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL * sizeof(uint32));
 	RCT2_GLOBAL(0x00F1AD6C, uint32) = 0;
+	_fullSweepRowsLeft = MAXIMUM_MAP_SIZE_TECHNICAL;
+	map_minimap_clear_dirty_tiles();
 }
 
 /**
@@ -981,17 +996,17 @@ static void window_map_transform_to_map_coords(sint16 *left, sint16 *top)
 		temp = x;
 		x = y;
 		y = temp;
-		x = 0x1FFF - x;
+		x = (MAXIMUM_MAP_SIZE_BIG - 1) - x;
 		break;
 	case 2:
-		x = 0x1FFF - x;
-		y = 0x1FFF - y;
+		x = (MAXIMUM_MAP_SIZE_BIG - 1) - x;
+		y = (MAXIMUM_MAP_SIZE_BIG - 1) - y;
 		break;
 	case 1:
 		temp = x;
 		x = y;
 		y = temp;
-		y = 0x1FFF - y;
+		y = (MAXIMUM_MAP_SIZE_BIG - 1) - y;
 		break;
 	case 0:
 		break;
@@ -1338,7 +1353,7 @@ static void window_map_set_peep_spawn_tool_down(int x, int y)
  */
 static void map_window_increase_map_size()
 {
-	if (gMapSize >= 256) {
+	if (gMapSize >= MAXIMUM_MAP_SIZE_TECHNICAL) {
 		window_error_open(STR_CANT_INCREASE_MAP_SIZE_ANY_FURTHER, STR_NONE);
 		return;
 	}
@@ -1615,26 +1630,26 @@ static void map_window_set_pixels(rct_window *w)
 		dy = 32;
 		break;
 	case 1:
-		x = 8192 - 32;
+		x = MAXIMUM_MAP_SIZE_BIG - 32;
 		y = RCT2_GLOBAL(0x00F1AD6C, uint32) * 32;
 		dx = -32;
 		dy = 0;
 		break;
 	case 2:
-		x = (255 - RCT2_GLOBAL(0x00F1AD6C, uint32)) * 32;
-		y = 8192 - 32;
+		x = (MAXIMUM_MAP_SIZE_TECHNICAL - 1 - RCT2_GLOBAL(0x00F1AD6C, uint32)) * 32;
+		y = MAXIMUM_MAP_SIZE_BIG - 32;
 		dx = 0;
 		dy = -32;
 		break;
 	case 3:
 		x = 0;
-		y = (255 - RCT2_GLOBAL(0x00F1AD6C, uint32)) * 32;
+		y = (MAXIMUM_MAP_SIZE_TECHNICAL - 1 - RCT2_GLOBAL(0x00F1AD6C, uint32)) * 32;
 		dx = 32;
 		dy = 0;
 		break;
 	}
 
-	for (int i = 0; i < 256; i++) {
+	for (int i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++) {
 		if (
 			x > 0 &&
 			y > 0 &&
@@ -1656,10 +1671,53 @@ static void map_window_set_pixels(rct_window *w)
 		destination = (uint16*)((int)destination + 513);
 	}
 	RCT2_GLOBAL(0x00F1AD6C, uint32)++;
-	if (RCT2_GLOBAL(0x00F1AD6C, uint32) >= 256)
+	if (RCT2_GLOBAL(0x00F1AD6C, uint32) >= MAXIMUM_MAP_SIZE_TECHNICAL)
 		RCT2_GLOBAL(0x00F1AD6C, uint32) = 0;
 }
 
+/**
+ * Redraws the pixel of a single tile, at the position map_window_set_pixels would draw it.
+ */
+static void map_window_set_tile_pixel(rct_window *w, int tileX, int tileY)
+{
+	int row = 0, column = 0;
+	uint16 colour = 0, *destination;
+
+	if (tileX <= 0 || tileY <= 0 || tileX * 32 >= gMapSizeUnits || tileY * 32 >= gMapSizeUnits)
+		return;
+
+	switch (get_current_rotation()) {
+	case 0:
+		row = tileX;
+		column = tileY;
+		break;
+	case 1:
+		row = tileY;
+		column = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tileX;
+		break;
+	case 2:
+		row = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tileX;
+		column = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tileY;
+		break;
+	case 3:
+		row = MAXIMUM_MAP_SIZE_TECHNICAL - 1 - tileY;
+		column = tileX;
+		break;
+	}
+
+	switch (w->selected_tab) {
+	case PAGE_PEEPS:
+		colour = map_window_get_pixel_colour_peep(tileX * 32, tileY * 32);
+		break;
+	case PAGE_RIDES:
+		colour = map_window_get_pixel_colour_ride(tileX * 32, tileY * 32);
+		break;
+	}
+
+	destination = (uint16*)((row * 511) + (column * 513) + RCT2_GLOBAL(RCT2_ADDRESS_MAP_IMAGE_DATA, uint32) + 255);
+	*destination = colour;
+}
+
 static void map_window_screen_to_map(int screenX, int screenY, int *mapX, int *mapY)
 {
 	int x, y;
@@ -1674,16 +1732,16 @@ static void map_window_screen_to_map(int screenX, int screenY, int *mapX, int *m
 		*mapY = y;
 		break;
 	case 1:
-		*mapX = 8191 - y;
+		*mapX = (MAXIMUM_MAP_SIZE_BIG - 1) - y;
 		*mapY = x;
 		break;
 	case 2:
-		*mapX = 8191 - x;
-		*mapY = 8191 - y;
+		*mapX = (MAXIMUM_MAP_SIZE_BIG - 1) - x;
+		*mapY = (MAXIMUM_MAP_SIZE_BIG - 1) - y;
 		break;
 	case 3:
 		*mapX = y;
-		*mapY = 8191 - x;
+		*mapY = (MAXIMUM_MAP_SIZE_BIG - 1) - x;
 		break;
 	}
 }
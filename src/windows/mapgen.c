@@ -393,10 +393,6 @@ static uint32 window_mapgen_page_hold_down_widgets[] = {
 
 const int window_mapgen_tab_animation_loops[] = { 16, 16, 16 };
 
-#define MINIMUM_MAP_SIZE_TECHNICAL 15
-#define MAXIMUM_MAP_SIZE_TECHNICAL 256
-#define MINIMUM_MAP_SIZE_PRACTICAL MINIMUM_MAP_SIZE_TECHNICAL-2
-#define MAXIMUM_MAP_SIZE_PRACTICAL MAXIMUM_MAP_SIZE_TECHNICAL-2
 #define BASESIZE_MIN 0
 #define BASESIZE_MAX 60
 #define WATERLEVEL_MIN 0
@@ -723,6 +719,7 @@ static void window_mapgen_random_mouseup(rct_window *w, int widgetIndex)
 		mapgenSettings.simplex_high = 12 + (util_rand() % (32 - 12));
 		mapgenSettings.simplex_base_freq = 1.75f;
 		mapgenSettings.simplex_octaves = 6;
+		mapgenSettings.seed = 0;
 
 		mapgen_generate(&mapgenSettings);
 		gfx_invalidate_screen();
@@ -810,6 +807,7 @@ static void window_mapgen_simplex_mouseup(rct_window *w, int widgetIndex)
 		mapgenSettings.simplex_high = _simplex_high;
 		mapgenSettings.simplex_base_freq = ((float)_simplex_base_freq) / 100.00f;
 		mapgenSettings.simplex_octaves = _simplex_octaves;
+		mapgenSettings.seed = 0;
 
 		mapgen_generate(&mapgenSettings);
 		gfx_invalidate_screen();
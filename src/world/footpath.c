@@ -1427,44 +1427,110 @@ void footpath_chain_ride_queue(int rideIndex, int entranceIndex, int x, int y, r
 }
 
 /**
- *
- *  rct2: 0x006A759F
+ * Re-chains the queues leading up to each of a ride's station entrances.
  */
-void sub_6A759F()
+static void footpath_chain_ride_queues(int rideIndex)
 {
-	uint8 *esi;
-	int i, x, y, z, direction, rideIndex;
+	int i, x, y, z, direction;
 	rct_ride *ride;
 	rct_map_element *mapElement;
 
-	for (esi = (uint8*)0x00F3EFF8; esi < RCT2_GLOBAL(0x00F3EFF4, uint8*); esi++) {
-		rideIndex = *esi;
-		ride = get_ride(rideIndex);
-		if (ride->type == RIDE_TYPE_NULL)
+	ride = get_ride(rideIndex);
+	if (ride->type == RIDE_TYPE_NULL)
+		return;
+
+	for (i = 0; i < 4; i++) {
+		if (ride->entrances[i] == 0xFFFF)
 			continue;
 
-		for (i = 0; i < 4; i++) {
-			if (ride->entrances[i] == 0xFFFF)
+		x = ride->entrances[i] & 0xFF;
+		y = ride->entrances[i] >> 8;
+		z = ride->station_heights[i];
+
+		mapElement = map_get_first_element_at(x, y);
+		do {
+			if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_ENTRANCE)
+				continue;
+			if (mapElement->base_height != z)
+				continue;
+			if (mapElement->properties.entrance.type != ENTRANCE_TYPE_RIDE_ENTRANCE)
 				continue;
 
-			x = ride->entrances[i] & 0xFF;
-			y = ride->entrances[i] >> 8;
-			z = ride->station_heights[i];
+			direction = (mapElement->type & 3) ^ 2;
+			footpath_chain_ride_queue(rideIndex, i, x << 5, y << 5, mapElement, direction);
+		} while (!map_element_is_last_for_tile(mapElement++));
+	}
+}
 
-			mapElement = map_get_first_element_at(x, y);
-			do {
-				if (map_element_get_type(mapElement) != MAP_ELEMENT_TYPE_ENTRANCE)
-					continue;
-				if (mapElement->base_height != z)
-					continue;
-				if (mapElement->properties.entrance.type != ENTRANCE_TYPE_RIDE_ENTRANCE)
-					continue;
+#if DEBUG_LEVEL_2
+/**
+ * Checks that skipping repeated entries gave the same map as chaining every queued entry, which is what the original
+ * game did. The map is left as the original would have left it.
+ */
+static void footpath_verify_ride_queue_chains(const rct_map_element *mapElementsBefore)
+{
+	size_t mapElementsSize = MAX_MAP_ELEMENTS * sizeof(rct_map_element);
+	rct_map_element *mapElementsChained = malloc(mapElementsSize);
+	memcpy(mapElementsChained, gMapElements, mapElementsSize);
 
-				direction = (mapElement->type & 3) ^ 2;
-				footpath_chain_ride_queue(rideIndex, i, x << 5, y << 5, mapElement, direction);
-			} while (!map_element_is_last_for_tile(mapElement++));
-		}
+	memcpy(gMapElements, mapElementsBefore, mapElementsSize);
+	for (uint8 *esi = (uint8*)0x00F3EFF8; esi < RCT2_GLOBAL(0x00F3EFF4, uint8*); esi++) {
+		footpath_chain_ride_queues(*esi);
+	}
+
+	if (memcmp(gMapElements, mapElementsChained, mapElementsSize) != 0) {
+		log_error("Queue chains differ from a rebuild of every queued ride entry.");
 	}
+	free(mapElementsChained);
+}
+#endif // DEBUG_LEVEL_2
+
+/**
+ * Whether chaining the ride's queues twice in a row gives the same result as chaining them once. A single queue walk
+ * only adds the back edge of each tile it enters, which the walk never takes as its next direction and which the
+ * Fix #2051 check already requires, so walking it again takes the same path. With more than one entrance, a later
+ * walk can add edges that an earlier walk then sees as forward edges on the next pass, so those rides are not safe.
+ */
+static bool footpath_ride_queue_chain_is_repeatable(int rideIndex)
+{
+	rct_ride *ride = get_ride(rideIndex);
+	int numEntrances = 0;
+	for (int i = 0; i < 4; i++) {
+		if (ride->entrances[i] != 0xFFFF)
+			numEntrances++;
+	}
+	return numEntrances <= 1;
+}
+
+/**
+ * Re-chains the queues of the rides whose queue or entrance tiles were touched since sub_6A7594 reset the list. A ride
+ * is added for every touched tile, so runs of the same ride are chained once when that is known to give the same
+ * result. A ride repeated after a different one is always chained again, because the other ride's chain may have added
+ * edges that change its walk.
+ *
+ *  rct2: 0x006A759F
+ */
+void sub_6A759F()
+{
+	uint8 *listStart = (uint8*)0x00F3EFF8;
+	uint8 *listEnd = RCT2_GLOBAL(0x00F3EFF4, uint8*);
+
+#if DEBUG_LEVEL_2
+	rct_map_element *mapElementsBefore = malloc(MAX_MAP_ELEMENTS * sizeof(rct_map_element));
+	memcpy(mapElementsBefore, gMapElements, MAX_MAP_ELEMENTS * sizeof(rct_map_element));
+#endif // DEBUG_LEVEL_2
+
+	for (uint8 *esi = listStart; esi < listEnd; esi++) {
+		if (esi != listStart && *esi == *(esi - 1) && footpath_ride_queue_chain_is_repeatable(*esi))
+			continue;
+
+		footpath_chain_ride_queues(*esi);
+	}
+
+#if DEBUG_LEVEL_2
+	footpath_verify_ride_queue_chains(mapElementsBefore);
+	free(mapElementsBefore);
+#endif // DEBUG_LEVEL_2
 }
 
 /**
@@ -34,6 +34,7 @@
 #include "../ride/track.h"
 #include "../ride/track_data.h"
 #include "../scenario.h"
+#include "../util/util.h"
 #include "banner.h"
 #include "climate.h"
 #include "footpath.h"
@@ -80,6 +81,11 @@ money32 gWaterToolLowerCost;
 
 rct_xyz16 gCommandPosition;
 
+// Tiles that have changed since the map window last redrew them, one bit per tile
+static uint32 _minimapDirtyTiles[MAX_TILE_MAP_ELEMENT_POINTERS / 32];
+static int _minimapNumDirtyTiles = 0;
+static int _minimapDirtyTilesCursor = 0;
+
 static void tiles_init();
 static void map_update_grass_length(int x, int y, rct_map_element *mapElement);
 static void map_set_grass_length(int x, int y, rct_map_element *mapElement, int length);
@@ -154,13 +160,13 @@ int map_element_iterator_next(map_element_iterator *it)
 		return 1;
 	}
 
-	if (it->x < 255) {
+	if (it->x < MAXIMUM_MAP_SIZE_TECHNICAL - 1) {
 		it->x++;
 		it->element = map_get_first_element_at(it->x, it->y);
 		return 1;
 	}
 
-	if (it->y < 255) {
+	if (it->y < MAXIMUM_MAP_SIZE_TECHNICAL - 1) {
 		it->x = 0;
 		it->y++;
 		it->element = map_get_first_element_at(it->x, it->y);
@@ -177,20 +183,20 @@ void map_element_iterator_restart_for_tile(map_element_iterator *it)
 
 rct_map_element *map_get_first_element_at(int x, int y)
 {
-	if (x < 0 || y < 0 || x > 255 || y > 255) {
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL) {
 		log_error("Trying to access element outside of range");
 		return NULL;
 	}
-	return TILE_MAP_ELEMENT_POINTER(x + y * 256);
+	return TILE_MAP_ELEMENT_POINTER(x + y * MAXIMUM_MAP_SIZE_TECHNICAL);
 }
 
 void map_set_tile_elements(int x, int y, rct_map_element *elements)
 {
-	if (x < 0 || y < 0 || x > 255 || y > 255) {
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL) {
 		log_error("Trying to access element outside of range");
 		return;
 	}
-	TILE_MAP_ELEMENT_POINTER(x + y * 256) = elements;
+	TILE_MAP_ELEMENT_POINTER(x + y * MAXIMUM_MAP_SIZE_TECHNICAL) = elements;
 }
 
 int map_element_is_last_for_tile(const rct_map_element *element)
@@ -362,8 +368,8 @@ void map_update_tile_pointers()
 
 	rct_map_element *mapElement = RCT2_ADDRESS(RCT2_ADDRESS_MAP_ELEMENTS, rct_map_element);
 	rct_map_element **tile = RCT2_ADDRESS(RCT2_ADDRESS_TILE_MAP_ELEMENT_POINTERS, rct_map_element*);
-	for (y = 0; y < 256; y++) {
-		for (x = 0; x < 256; x++) {
+	for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+		for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
 			*tile++ = mapElement;
 			while (!map_element_is_last_for_tile(mapElement++));
 		}
@@ -385,7 +391,7 @@ int map_element_height(int x, int y)
 	rct_map_element *mapElement;
 
 	// Off the map
-	if ((unsigned)x >= 8192 || (unsigned)y >= 8192)
+	if ((unsigned)x >= MAXIMUM_MAP_SIZE_BIG || (unsigned)y >= MAXIMUM_MAP_SIZE_BIG)
 		return 16;
 
 	// Truncate subtile coordinates
@@ -616,10 +622,10 @@ void map_update_path_wide_flags()
 
 		// Next x, y tile
 		x += 32;
-		if (x >= 8192) {
+		if (x >= MAXIMUM_MAP_SIZE_BIG) {
 			x = 0;
 			y += 32;
-			if (y >= 8192) {
+			if (y >= MAXIMUM_MAP_SIZE_BIG) {
 				y = 0;
 			}
 		}
@@ -659,7 +665,7 @@ int map_is_location_owned(int x, int y, int z)
 	rct_map_element *mapElement;
 
 	// This check is to avoid throwing lots of messages in logs.
-	if (x < (256 * 32) && y < (256 * 32)) {
+	if (x < MAXIMUM_MAP_SIZE_BIG && y < MAXIMUM_MAP_SIZE_BIG) {
 		mapElement = map_get_surface_element_at(x / 32, y / 32);
 		if (mapElement != NULL) {
 			if (mapElement->properties.surface.ownership & OWNERSHIP_OWNED)
@@ -685,7 +691,7 @@ int map_is_location_in_park(int x, int y)
 {
 	rct_map_element *mapElement;
 
-	if (x < (256 * 32) && y < (256 * 32)) {
+	if (x < MAXIMUM_MAP_SIZE_BIG && y < MAXIMUM_MAP_SIZE_BIG) {
 		mapElement = map_get_surface_element_at(x / 32, y / 32);
 		if (mapElement == NULL)
 			return 0;
@@ -701,7 +707,7 @@ bool map_is_location_owned_or_has_rights(int x, int y)
 {
 	rct_map_element *mapElement;
 
-	if (x < (256 * 32) && y < (256 * 32)) {
+	if (x < MAXIMUM_MAP_SIZE_BIG && y < MAXIMUM_MAP_SIZE_BIG) {
 		mapElement = map_get_surface_element_at(x / 32, y / 32);
 		if (mapElement->properties.surface.ownership & OWNERSHIP_OWNED) return true;
 		if (mapElement->properties.surface.ownership & OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED) return true;
@@ -1361,8 +1367,8 @@ restart_from_beginning:
 void map_reset_clear_large_scenery_flag(){
 	rct_map_element* mapElement;
 	// TODO: Improve efficiency of this
-	for (int y = 0; y <= 255; y++) {
-		for (int x = 0; x <= 255; x++) {
+	for (int y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+		for (int x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
 			mapElement = map_get_first_element_at(x, y);
 			do {
 				if (map_element_get_type(mapElement) == MAP_ELEMENT_TYPE_SCENERY_MULTIPLE) {
@@ -1479,8 +1485,8 @@ money32 map_change_surface_style(int x0, int y0, int x1, int y1, uint8 surfaceSt
 
 	for (int x = x0; x <= x1; x += 32) {
 		for (int y = y0; y <= y1; y += 32) {
-			if (x > 0x1FFF) continue;
-			if (y > 0x1FFF) continue;
+			if (x >= MAXIMUM_MAP_SIZE_BIG) continue;
+			if (y >= MAXIMUM_MAP_SIZE_BIG) continue;
 
 			if (!(gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR) && !gCheatsSandboxMode) {
 				if (!map_is_location_in_park(x, y)) continue;
@@ -2248,7 +2254,7 @@ static int map_get_corner_height(rct_map_element *mapElement, int direction)
 static money32 smooth_land_tile(int direction, uint8 flags, int x, int y, int targetBaseZ, int minBaseZ)
 {
 	// Check if inside map bounds
-	if (x < 0 || y < 0 || x >= (256 * 32) || y >= (256 * 32)) {
+	if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_BIG || y >= MAXIMUM_MAP_SIZE_BIG) {
 		return MONEY32_UNDEFINED;
 	}
 
@@ -2302,8 +2308,8 @@ money32 smooth_land(int flags, int centreX, int centreY, int mapLeft, int mapTop
 	// Cap bounds to map
 	mapLeft = max(mapLeft, 32);
 	mapTop = max(mapTop, 32);
-	mapRight = clamp(0, mapRight, 255 * 32);
-	mapBottom = clamp(0, mapBottom, 255 * 32);
+	mapRight = clamp(0, mapRight, (MAXIMUM_MAP_SIZE_BIG - 32));
+	mapBottom = clamp(0, mapBottom, (MAXIMUM_MAP_SIZE_BIG - 32));
 
 	int commandType;
 	int centreZ = map_element_height(centreX, centreY);
@@ -2371,7 +2377,7 @@ money32 smooth_land(int flags, int centreX, int centreY, int mapLeft, int mapTop
 	int size = ((mapRight - mapLeft) >> 5) + 1;
 	int initialMinZ = -2;
 
-	for (; size <= 256; size += 2) {
+	for (; size <= MAXIMUM_MAP_SIZE_TECHNICAL; size += 2) {
 		initialMinZ += 2;
 		int minZ = initialMinZ * 2;
 		x -= 32;
@@ -2736,7 +2742,7 @@ void game_command_place_banner(int* eax, int* ebx, int* ecx, int* edx, int* esi,
 		return;
 	}
 
-	if (x >= 8192 || y >= 8192) {
+	if (x >= MAXIMUM_MAP_SIZE_BIG || y >= MAXIMUM_MAP_SIZE_BIG) {
 		*ebx = MONEY32_UNDEFINED;
 		return;
 	}
@@ -3096,7 +3102,7 @@ void game_command_place_scenery(int* eax, int* ebx, int* ecx, int* edx, int* esi
 
 static bool map_is_location_at_edge(int x, int y)
 {
-	return x < 32 || y < 32 || x >= ((256 - 1) * 32) || y >= ((256 - 1) * 32);
+	return x < 32 || y < 32 || x >= (MAXIMUM_MAP_SIZE_BIG - 32) || y >= (MAXIMUM_MAP_SIZE_BIG - 32);
 }
 
 /**
@@ -3626,7 +3632,7 @@ void game_command_place_large_scenery(int* eax, int* ebx, int* ecx, int* edx, in
 		curTile.x += x;
 		curTile.y += y;
 
-		if(curTile.x >= 0x1FFF || curTile.y >= 0x1FFF || curTile.x < 0 || curTile.y < 0){
+		if(curTile.x >= MAXIMUM_MAP_SIZE_BIG - 1 || curTile.y >= MAXIMUM_MAP_SIZE_BIG - 1 || curTile.x < 0 || curTile.y < 0){
 			continue;
 		}
 
@@ -3920,8 +3926,8 @@ void map_reorganise_elements()
 
 	uint32 num_elements;
 
-	for (int y = 0; y < 256; y++) {
-		for (int x = 0; x < 256; x++) {
+	for (int y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+		for (int x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
 			rct_map_element *startElement = map_get_first_element_at(x, y);
 			rct_map_element *endElement = startElement;
 			while (!map_element_is_last_for_tile(endElement++));
@@ -3966,6 +3972,70 @@ int sub_68B044()
 	}
 }
 
+/**
+ * Checks whether a map element slot is unused and can be claimed by an adjacent tile.
+ * Slots are either freed elements (base height of 255) or the slot at the end of the used element storage.
+ */
+static bool map_element_is_free_slot(rct_map_element *mapElement)
+{
+	if (mapElement < RCT2_ADDRESS(RCT2_ADDRESS_MAP_ELEMENTS, rct_map_element))
+		return false;
+	if (mapElement == gNextFreeMapElement)
+		return mapElement <= RCT2_ADDRESS(RCT2_ADDRESS_MAP_ELEMENTS_END, rct_map_element);
+	return mapElement < gNextFreeMapElement && mapElement->base_height == 255;
+}
+
+/**
+ * Inserts a new map element into the tile's existing element block by growing it into a free slot
+ * directly above or below the block. This avoids relocating the whole tile to the end of the element
+ * storage, which leaves dead slots behind and eventually forces a full map_reorganise_elements.
+ * @returns the inserted element or NULL if the tile has no adjacent free slot.
+ */
+static rct_map_element *map_element_insert_in_place(int x, int y, int z, int flags)
+{
+	rct_map_element *firstMapElement, *lastMapElement, *insertMapElement;
+
+	firstMapElement = TILE_MAP_ELEMENT_POINTER(y * MAXIMUM_MAP_SIZE_TECHNICAL + x);
+	if (firstMapElement == TILE_UNDEFINED_MAP_ELEMENT)
+		return NULL;
+
+	// Find the position above all elements at or below the insert height
+	insertMapElement = firstMapElement;
+	while (z >= insertMapElement->base_height) {
+		if (map_element_is_last_for_tile(insertMapElement++)) {
+			flags |= MAP_ELEMENT_FLAG_LAST_TILE;
+			break;
+		}
+	}
+
+	lastMapElement = insertMapElement > firstMapElement ? insertMapElement - 1 : firstMapElement;
+	while (!map_element_is_last_for_tile(lastMapElement))
+		lastMapElement++;
+
+	if (map_element_is_free_slot(lastMapElement + 1)) {
+		// Shift the elements above the insert height up by one
+		if (lastMapElement + 1 == gNextFreeMapElement)
+			gNextFreeMapElement++;
+		memmove(insertMapElement + 1, insertMapElement, (lastMapElement + 1 - insertMapElement) * sizeof(rct_map_element));
+	} else if (map_element_is_free_slot(firstMapElement - 1)) {
+		// Shift the elements below the insert height down by one
+		memmove(firstMapElement - 1, firstMapElement, (insertMapElement - firstMapElement) * sizeof(rct_map_element));
+		TILE_MAP_ELEMENT_POINTER(y * MAXIMUM_MAP_SIZE_TECHNICAL + x) = firstMapElement - 1;
+		insertMapElement--;
+	} else {
+		return NULL;
+	}
+
+	if (flags & MAP_ELEMENT_FLAG_LAST_TILE)
+		(insertMapElement - 1)->flags &= ~MAP_ELEMENT_FLAG_LAST_TILE;
+
+	insertMapElement->base_height = z;
+	insertMapElement->flags = flags;
+	insertMapElement->clearance_height = z;
+	memset(&insertMapElement->properties, 0, sizeof(insertMapElement->properties));
+	return insertMapElement;
+}
+
 /**
  *
  *  rct2: 0x0068B1F6
@@ -3974,16 +4044,22 @@ rct_map_element *map_element_insert(int x, int y, int z, int flags)
 {
 	rct_map_element *originalMapElement, *newMapElement, *insertedElement;
 
+	map_minimap_invalidate_tile(x, y);
+
+	insertedElement = map_element_insert_in_place(x, y, z, flags);
+	if (insertedElement != NULL)
+		return insertedElement;
+
 	if (!sub_68B044()) {
 		log_error("Cannot insert new element");
 		return NULL;
 	}
 
 	newMapElement = gNextFreeMapElement;
-	originalMapElement = TILE_MAP_ELEMENT_POINTER(y * 256 + x);
+	originalMapElement = TILE_MAP_ELEMENT_POINTER(y * MAXIMUM_MAP_SIZE_TECHNICAL + x);
 
 	// Set tile index pointer to point to new element block
-	TILE_MAP_ELEMENT_POINTER(y * 256 + x) = newMapElement;
+	TILE_MAP_ELEMENT_POINTER(y * MAXIMUM_MAP_SIZE_TECHNICAL + x) = newMapElement;
 
 	// Copy all elements that are below the insert height
 	while (z >= originalMapElement->base_height) {
@@ -4393,8 +4469,8 @@ void map_remove_out_of_range_elements()
 {
 	int mapMaxXY = gMapSizeMaxXY;
 
-	for (int y = 0; y < (256 * 32); y += 32) {
-		for (int x = 0; x < (256 * 32); x += 32) {
+	for (int y = 0; y < MAXIMUM_MAP_SIZE_BIG; y += 32) {
+		for (int x = 0; x < MAXIMUM_MAP_SIZE_BIG; x += 32) {
 			if (x == 0 || y == 0 || x >= mapMaxXY || y >= mapMaxXY) {
 				map_buy_land_rights(x, y, x, y, 1, GAME_COMMAND_FLAG_APPLY);
 				clear_elements_at(x, y);
@@ -4413,7 +4489,7 @@ void map_extend_boundary_surface()
 	int x, y, z, slope;
 
 	y = gMapSize - 2;
-	for (x = 0; x < 256; x++) {
+	for (x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
 		existingMapElement = map_get_surface_element_at(x, y - 1);
 		newMapElement = map_get_surface_element_at(x, y);
 
@@ -4449,7 +4525,7 @@ void map_extend_boundary_surface()
 	}
 
 	x = gMapSize - 2;
-	for (y = 0; y < 256; y++) {
+	for (y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
 		existingMapElement = map_get_surface_element_at(x - 1, y);
 		newMapElement = map_get_surface_element_at(x, y);
 
@@ -4810,9 +4886,60 @@ void map_invalidate_tile_under_zoom(int x, int y, int z0, int z1, int maxZoom)
  */
 void map_invalidate_tile(int x, int y, int z0, int z1)
 {
+	map_minimap_invalidate_tile(x >> 5, y >> 5);
 	map_invalidate_tile_under_zoom(x, y, z0, z1, -1);
 }
 
+/**
+ * Marks a tile (in tile coordinates) as needing to be redrawn on the map window.
+ */
+void map_minimap_invalidate_tile(int x, int y)
+{
+	if ((unsigned)x >= MAXIMUM_MAP_SIZE_TECHNICAL || (unsigned)y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+		return;
+
+	int index = y * MAXIMUM_MAP_SIZE_TECHNICAL + x;
+	uint32 bit = 1u << (index & 31);
+	if (!(_minimapDirtyTiles[index >> 5] & bit)) {
+		_minimapDirtyTiles[index >> 5] |= bit;
+		_minimapNumDirtyTiles++;
+	}
+}
+
+/**
+ * Forgets all tiles marked by map_minimap_invalidate_tile, for when the whole map window image is about to be
+ * redrawn anyway. Tiles keep being marked while the map window is closed.
+ */
+void map_minimap_clear_dirty_tiles()
+{
+	memset(_minimapDirtyTiles, 0, sizeof(_minimapDirtyTiles));
+	_minimapNumDirtyTiles = 0;
+	_minimapDirtyTilesCursor = 0;
+}
+
+/**
+ * Takes the next tile marked by map_minimap_invalidate_tile.
+ * @returns false when there are no more changed tiles.
+ */
+bool map_minimap_pop_dirty_tile(int *x, int *y)
+{
+	if (_minimapNumDirtyTiles == 0)
+		return false;
+
+	while (_minimapDirtyTiles[_minimapDirtyTilesCursor] == 0)
+		_minimapDirtyTilesCursor = (_minimapDirtyTilesCursor + 1) % countof(_minimapDirtyTiles);
+
+	uint32 *word = &_minimapDirtyTiles[_minimapDirtyTilesCursor];
+	int bitIndex = bitscanforward(*word);
+	*word &= ~(1u << bitIndex);
+	_minimapNumDirtyTiles--;
+
+	int index = (_minimapDirtyTilesCursor << 5) + bitIndex;
+	*x = index % MAXIMUM_MAP_SIZE_TECHNICAL;
+	*y = index / MAXIMUM_MAP_SIZE_TECHNICAL;
+	return true;
+}
+
 /**
  *
  *  rct2: 0x006ECB60
@@ -4869,7 +4996,7 @@ int map_get_tile_quadrant(int mapX, int mapY)
  */
 bool map_surface_is_blocked(sint16 x, sint16 y){
 	rct_map_element *mapElement;
-	if (x >= 8192 || y >= 8192)
+	if (x >= MAXIMUM_MAP_SIZE_BIG || y >= MAXIMUM_MAP_SIZE_BIG)
 		return true;
 
 	mapElement = map_get_surface_element_at(x / 32, y / 32);
@@ -4908,8 +5035,8 @@ bool map_surface_is_blocked(sint16 x, sint16 y){
 /* Clears all map elements, to be used before generating a new map */
 void map_clear_all_elements()
 {
-	for (int y = 0; y < (256 * 32); y += 32) {
-		for (int x = 0; x < (256 * 32); x += 32) {
+	for (int y = 0; y < MAXIMUM_MAP_SIZE_BIG; y += 32) {
+		for (int x = 0; x < MAXIMUM_MAP_SIZE_BIG; x += 32) {
 			clear_elements_at(x, y);
 		}
 	}
@@ -225,8 +225,16 @@ enum {
 
 #define MAP_MINIMUM_X_Y -256
 
+#define MINIMUM_MAP_SIZE_TECHNICAL 15
+#define MAXIMUM_MAP_SIZE_TECHNICAL 256
+#define MINIMUM_MAP_SIZE_PRACTICAL (MINIMUM_MAP_SIZE_TECHNICAL-2)
+#define MAXIMUM_MAP_SIZE_PRACTICAL (MAXIMUM_MAP_SIZE_TECHNICAL-2)
+
+// Largest map size in map units (32 per tile), any coordinate at or beyond this is off the map
+#define MAXIMUM_MAP_SIZE_BIG (MAXIMUM_MAP_SIZE_TECHNICAL * 32)
+
 #define MAX_MAP_ELEMENTS 196608
-#define MAX_TILE_MAP_ELEMENT_POINTERS (256 * 256)
+#define MAX_TILE_MAP_ELEMENT_POINTERS (MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL)
 
 #define MAP_ELEMENT_LARGE_TYPE_MASK 0x3FF
 
@@ -413,6 +421,9 @@ void map_invalidate_tile_zoom1(int x, int y, int z0, int z1);
 void map_invalidate_tile_zoom0(int x, int y, int z0, int z1);
 void map_invalidate_tile_full(int x, int y);
 void map_invalidate_element(int x, int y, rct_map_element *mapElement);
+void map_minimap_invalidate_tile(int x, int y);
+void map_minimap_clear_dirty_tiles();
+bool map_minimap_pop_dirty_tile(int *x, int *y);
 
 int map_get_tile_side(int mapX, int mapY);
 int map_get_tile_quadrant(int mapX, int mapY);
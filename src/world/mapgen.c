@@ -19,6 +19,7 @@
  *****************************************************************************/
 
 #include <time.h>
+#include <SDL.h>
 #include "../addresses.h"
 #include "../object.h"
 #include "../util/util.h"
@@ -127,7 +128,10 @@ void mapgen_generate(mapgen_settings *settings)
 	int x, y, mapSize, floorTexture, wallTexture, waterLevel;
 	rct_map_element *mapElement;
 
-	util_srand((unsigned int)time(NULL));
+	// Everything below draws from util_rand, so the same seed and settings give the same map
+	if (settings->seed == 0)
+		settings->seed = (unsigned int)time(NULL);
+	util_srand(settings->seed);
 
 	mapSize = settings->mapSize;
 	floorTexture = settings->floor;
@@ -293,7 +297,7 @@ static void mapgen_place_trees()
 
 	int availablePositionsCount = 0;
 	struct { int x; int y; } tmp, *pos, *availablePositions;
-	availablePositions = malloc(256 * 256 * sizeof(tmp));
+	availablePositions = malloc(MAX_TILE_MAP_ELEMENT_POINTERS * sizeof(tmp));
 
 	// Create list of available tiles
 	for (y = 1; y < mapSize - 1; y++) {
@@ -576,30 +580,55 @@ static void mapgen_blob(int cx, int cy, int size, int height)
 	mapgen_blob_fill(height);
 }
 
+static void mapgen_smooth_row_sums(const uint8 *row, uint16 *sums)
+{
+	int sum = row[0] + row[1] + row[2];
+	sums[1] = sum;
+	for (int x = 2; x < _heightSize - 1; x++) {
+		sum += row[x + 1] - row[x - 2];
+		sums[x] = sum;
+	}
+}
+
 /**
  * Smooths the height map.
+ * Each pass is a 3x3 box filter done separably with running sums over a rolling window of three rows, so it can
+ * work in place without copying the height map.
  */
 static void mapgen_smooth_height(int iterations)
 {
-	int i, x, y, xx, yy, avg;
-	int arraySize = _heightSize * _heightSize * sizeof(uint8);
-	uint8 *copyHeight = malloc(arraySize);
+	int i, x, y;
+	int size = _heightSize;
+	if (size < 3)
+		return;
+
+	uint16 *rowSums[3];
+	uint16 *rowSumsBuffer = malloc(3 * size * sizeof(uint16));
+	for (i = 0; i < 3; i++)
+		rowSums[i] = &rowSumsBuffer[i * size];
 
 	for (i = 0; i < iterations; i++) {
-		memcpy(copyHeight, _height, arraySize);
-		for (y = 1; y < _heightSize - 1; y++) {
-			for (x = 1; x < _heightSize - 1; x++) {
-				avg = 0;
-				for (yy = -1; yy <= 1; yy++)
-					for (xx = -1; xx <= 1; xx++)
-						avg += copyHeight[(y + yy) * _heightSize + (x + xx)];
-				avg /= 9;
-				set_height(x, y, avg);
-			}
+		mapgen_smooth_row_sums(&_height[0], rowSums[0]);
+		mapgen_smooth_row_sums(&_height[size], rowSums[1]);
+		for (y = 1; y < size - 1; y++) {
+			// Sum the row below before it is needed, this row is only overwritten after its own sums were taken
+			mapgen_smooth_row_sums(&_height[(y + 1) * size], rowSums[2]);
+
+			uint8 *dst = &_height[y * size];
+			const uint16 *above = rowSums[0];
+			const uint16 *middle = rowSums[1];
+			const uint16 *below = rowSums[2];
+			for (x = 1; x < size - 1; x++)
+				dst[x] = (above[x] + middle[x] + below[x]) / 9;
+
+			uint16 *recycled = rowSums[0];
+			rowSums[0] = rowSums[1];
+			rowSums[1] = rowSums[2];
+			rowSums[2] = recycled;
 		}
 	}
 
-	free(copyHeight);
+	free(rowSumsBuffer);
 }
 
 /**
@@ -660,16 +689,63 @@ static void noise_rand()
 		perm[i] = util_rand() & 0xFF;
 }
 
-static float fractal_noise(int x, int y, float frequency, int octaves, float lacunarity, float persistence)
+#define MAPGEN_MAX_OCTAVES 16
+#define MAPGEN_MAX_THREADS 8
+
+typedef struct {
+	int octaves;
+	float frequencies[MAPGEN_MAX_OCTAVES];
+	float amplitudes[MAPGEN_MAX_OCTAVES];
+	int low;
+	int high;
+	int startY;
+	int endY;
+} mapgen_simplex_job;
+
+static void fractal_noise_init(mapgen_simplex_job *job, float frequency, int octaves, float lacunarity, float persistence)
 {
-	float total = 0.0f;
 	float amplitude = persistence;
-	for (int i = 0; i < octaves; i++) {
-		total += generate(x * frequency, y * frequency) * amplitude;
+	job->octaves = min(octaves, MAPGEN_MAX_OCTAVES);
+	for (int i = 0; i < job->octaves; i++) {
+		job->frequencies[i] = frequency;
+		job->amplitudes[i] = amplitude;
 		frequency *= lacunarity;
 		amplitude *= persistence;
 	}
-	return total;
+}
+
+/**
+ * Fills the height map rows of a job. The octave scales are precomputed and every pixel only depends on the
+ * permutation table, so bands of rows can be generated independently on separate threads.
+ */
+static int mapgen_simplex_rows(void *arg)
+{
+	mapgen_simplex_job *job = (mapgen_simplex_job*)arg;
+	float *rowNoise = malloc(_heightSize * sizeof(float));
+
+	for (int y = job->startY; y < job->endY; y++) {
+		for (int x = 0; x < _heightSize; x++)
+			rowNoise[x] = 0.0f;
+
+		for (int i = 0; i < job->octaves; i++) {
+			float frequency = job->frequencies[i];
+			float amplitude = job->amplitudes[i];
+			float noiseY = y * frequency;
+			for (int x = 0; x < _heightSize; x++)
+				rowNoise[x] += generate(x * frequency, noiseY) * amplitude;
+		}
+
+		uint8 *dst = &_height[y * _heightSize];
+		for (int x = 0; x < _heightSize; x++) {
+			float noiseValue = clamp(-1.0f, rowNoise[x], 1.0f);
+			float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
+
+			dst[x] = (uint8)(job->low + (int)(normalisedNoiseValue * job->high));
+		}
+	}
+
+	free(rowNoise);
+	return 0;
 }
 
 static float generate(float x, float y)
@@ -753,22 +829,35 @@ static float grad(int hash, float x, float y)
 
 static void mapgen_simplex(mapgen_settings *settings)
 {
-	int x, y;
+	int i;
+	mapgen_simplex_job jobs[MAPGEN_MAX_THREADS];
+	SDL_Thread *threads[MAPGEN_MAX_THREADS];
 
 	float freq = settings->simplex_base_freq * (1.0f / _heightSize);
-	int octaves = settings->simplex_octaves;
-
-	int low = settings->simplex_low;
-	int high = settings->simplex_high;
 
 	noise_rand();
-	for (y = 0; y < _heightSize; y++) {
-		for (x = 0; x < _heightSize; x++) {
-			float noiseValue = clamp(-1.0f, fractal_noise(x, y, freq, octaves, 2.0f, 0.65f), 1.0f);
-			float normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
 
-			set_height(x, y, low + (int)(normalisedNoiseValue * high));
-		}
+	// Split the height map into bands of rows, one per thread
+	int numJobs = clamp(1, SDL_GetCPUCount(), MAPGEN_MAX_THREADS);
+	numJobs = min(numJobs, max(1, _heightSize / 64));
+	for (i = 0; i < numJobs; i++) {
+		mapgen_simplex_job *job = &jobs[i];
+		fractal_noise_init(job, freq, settings->simplex_octaves, 2.0f, 0.65f);
+		job->low = settings->simplex_low;
+		job->high = settings->simplex_high;
+		job->startY = (_heightSize * i) / numJobs;
+		job->endY = (_heightSize * (i + 1)) / numJobs;
+	}
+
+	for (i = 1; i < numJobs; i++) {
+		threads[i] = SDL_CreateThread(mapgen_simplex_rows, "mapgen", &jobs[i]);
+		if (threads[i] == NULL)
+			mapgen_simplex_rows(&jobs[i]);
+	}
+	mapgen_simplex_rows(&jobs[0]);
+	for (i = 1; i < numJobs; i++) {
+		if (threads[i] != NULL)
+			SDL_WaitThread(threads[i], NULL);
 	}
 }
 
@@ -37,6 +37,9 @@ typedef struct {
 	int simplex_high;
 	float simplex_base_freq;
 	int simplex_octaves;
+
+	// Random seed, 0 picks one from the current time. The seed used is written back so it can be reported.
+	unsigned int seed;
 } mapgen_settings;
 
 void mapgen_generate_blank(mapgen_settings *settings);
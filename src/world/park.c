@@ -196,26 +196,13 @@ int calculate_park_rating()
 
 	// Guests
 	{
-		rct_peep* peep;
-		uint16 spriteIndex;
-		int num_happy_peeps;
-		int num_lost_guests;
+		const rct_guest_histogram *histogram = peep_get_guest_histogram();
+		int num_happy_peeps = histogram->happy_guests;
+		int num_lost_guests = histogram->lost_guests;
 
 		// -150 to +3 based on a range of guests from 0 to 2000
 		result -= 150 - (min(2000, gNumGuestsInPark) / 13);
 
-		// Find the number of happy peeps and the number of peeps who can't find the park exit
-		num_happy_peeps = 0;
-		num_lost_guests = 0;
-		FOR_ALL_GUESTS(spriteIndex, peep) {
-			if (peep->outside_of_park != 0)
-				continue;
-			if (peep->happiness > 128)
-				num_happy_peeps++;
-			if ((peep->peep_flags & PEEP_FLAGS_LEAVING_PARK) && (peep->peep_is_lost_countdown < 90))
-				num_lost_guests++;
-		}
-
 		// Peep happiness -500 to +0
 		result -= 500;
 